@@ -21,7 +21,7 @@ typedef enum default_type {
     DEFAULT_TYPE_NULL
 } default_type_t;
 
-typedef struct default_descriptor {
+typedef struct default_descriptor : pooled_node_t {
     default_type_t type;
     lexeme_t lexeme;
     size_t precision;
@@ -32,7 +32,7 @@ typedef struct default_descriptor {
     {}
 } default_descriptor_t;
 
-typedef struct column_definition {
+typedef struct column_definition : pooled_node_t {
     lexeme_t name;
     std::unique_ptr<data_type_descriptor_t> data_type;
     std::unique_ptr<default_descriptor_t> default_descriptor;
@@ -9,7 +9,7 @@
 
 namespace sqltoast {
 
-typedef struct derived_column {
+typedef struct derived_column : pooled_node_t {
     lexeme_t alias;
     std::unique_ptr<value_expression_t> value;
     // Specialized constructor for the "asterisk" projection
@@ -19,18 +19,18 @@ typedef struct derived_column {
         value(std::move(ve))
     {}
     inline bool has_alias() const {
-        return alias.start != parse_position_t(0);
+        return alias.start != nullptr;
     }
 } derived_column_t;
 
-typedef struct grouping_column_reference {
+typedef struct grouping_column_reference : pooled_node_t {
     lexeme_t column;
     lexeme_t collation;
     grouping_column_reference(lexeme_t& column) :
         column(column)
     {}
     inline bool has_collation() const {
-        return collation.start != parse_position_t(0);
+        return collation.start != nullptr;
     }
 } grouping_column_reference_t;
 
@@ -18,13 +18,14 @@ typedef enum constraint_type {
     CONSTRAINT_TYPE_CHECK
 } constraint_type_t;
 
-typedef struct constraint {
+typedef struct constraint : pooled_node_t {
     constraint_type_t type;
     lexeme_t name;
     std::vector<lexeme_t> columns;
     constraint(constraint_type_t type) :
         type(type)
     {}
+    virtual ~constraint() {}
 } constraint_t;
 
 typedef struct not_null_constraint : constraint_t {
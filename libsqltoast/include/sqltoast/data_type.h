@@ -27,10 +27,11 @@ typedef enum data_type {
     DATA_TYPE_INTERVAL
 } data_type_t;
 
-typedef struct data_type_descriptor {
+typedef struct data_type_descriptor : pooled_node_t {
     data_type_t type;
     data_type_descriptor(data_type_t type) : type(type)
     {}
+    virtual ~data_type_descriptor() {}
 } data_type_descriptor_t;
 
 typedef struct char_string : data_type_descriptor_t {
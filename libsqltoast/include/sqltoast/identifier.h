@@ -9,7 +9,7 @@
 
 namespace sqltoast {
 
-typedef struct identifier {
+typedef struct identifier : pooled_node_t {
     const std::string name;
     identifier(lexeme_t& lexeme) : name(lexeme.start, lexeme.end)
     {}
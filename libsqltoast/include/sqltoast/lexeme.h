@@ -11,13 +11,46 @@ namespace sqltoast {
 
 typedef std::vector<char> parse_input_t;
 
-typedef parse_input_t::const_iterator parse_position_t;
+// A position within the input being parsed. Lexemes point directly into the
+// caller's memory, whatever container (if any) that memory belongs to, so the
+// input must outlive any parse result or token that refers to it.
+typedef const char* parse_position_t;
+
+// The number of zero bytes following the input in a padded_input_t. This is
+// at least as wide as the widest vector the lexer's scanners load.
+const size_t PADDED_INPUT_PADDING = 64;
+
+// Input to be parsed, copied into a buffer with PADDED_INPUT_PADDING zero
+// bytes after it. Because a zero byte never continues a token or a run of
+// whitespace, the lexer can read past the end of a token without first
+// checking whether it has reached the end of the input. Parsing a
+// padded_input_t gives exactly the same results as parsing the same bytes in
+// a parse_input_t.
+typedef struct padded_input {
+    parse_input_t buffer;
+    size_t size;
+    padded_input(const char* data, size_t len) :
+        buffer(data, data + len),
+        size(len)
+    {
+        buffer.resize(len + PADDED_INPUT_PADDING, '\0');
+    }
+    padded_input(const std::string& subject) :
+        padded_input(subject.data(), subject.size())
+    {}
+    inline parse_position_t cbegin() const {
+        return buffer.data();
+    }
+    inline parse_position_t cend() const {
+        return buffer.data() + size;
+    }
+} padded_input_t;
 
 // A lexeme_t demarcates some word or phrase within the tokenized input stream
 typedef struct lexeme {
     parse_position_t start;
     parse_position_t end;
-    lexeme() :start(0), end(0)
+    lexeme() :start(nullptr), end(nullptr)
     {}
     lexeme(
         parse_position_t start,
@@ -28,7 +61,7 @@ typedef struct lexeme {
         return end - start;
     }
     inline operator bool() const {
-        return start != parse_position_t(0);
+        return start != nullptr;
     }
 } lexeme_t;
 
@@ -0,0 +1,41 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_NODE_POOL_H
+#define SQLTOAST_NODE_POOL_H
+
+namespace sqltoast {
+
+// Memory for the structs making up a parsed statement comes from a pool
+// belonging to the thread that allocates it. When a statement is destroyed,
+// the memory of each struct goes back to the pool of the destroying thread,
+// to be handed out again by the next parse on that thread instead of going
+// back to the system allocator. A thread that parses many short statements
+// therefore stops allocating from the system once its pool is warm.
+
+// Returns memory for a node struct of the supplied size
+void* node_pool_alloc(size_t size);
+// Returns the memory of a node struct of the supplied size to the pool
+void node_pool_free(void* ptr, size_t size);
+// Releases all memory cached by the calling thread's pool to the system
+// allocator. A thread's pool is also released when the thread exits.
+void node_pool_trim();
+
+// Base of every struct in a parsed statement, routing the struct's
+// allocations through the node pool. It has no members and so adds nothing to
+// the size of a derived struct.
+typedef struct pooled_node {
+    static void* operator new(size_t size) {
+        return node_pool_alloc(size);
+    }
+    static void operator delete(void* ptr, size_t size) {
+        node_pool_free(ptr, size);
+    }
+} pooled_node_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_NODE_POOL_H */
@@ -12,7 +12,7 @@ namespace sqltoast {
 // A table expression describes the tables involved in a query expression along
 // with filtering, grouping and aggregate expressions on those tables
 
-typedef struct table_expression {
+typedef struct table_expression : pooled_node_t {
     std::vector<std::unique_ptr<table_reference_t>> referenced_tables;
     std::unique_ptr<search_condition_t> where_condition;
     std::vector<grouping_column_reference_t> group_by_columns;
@@ -29,7 +29,7 @@ typedef struct table_expression {
     {}
 } table_expression_t;
 
-typedef struct query_specification {
+typedef struct query_specification : pooled_node_t {
     bool distinct;
     std::vector<derived_column_t> selected_columns;
     std::unique_ptr<table_expression_t> table_expression;
@@ -50,11 +50,12 @@ typedef enum query_expression_type_t {
 
 // A query expression produces a table-like selection of rows.
 
-typedef struct query_expression {
+typedef struct query_expression : pooled_node_t {
     query_expression_type_t query_expression_type;
     query_expression(query_expression_type_t qe_type) :
         query_expression_type(qe_type)
     {}
+    virtual ~query_expression() {}
 } query_expression_t;
 
 typedef enum non_join_query_primary_type {
@@ -64,12 +65,13 @@ typedef enum non_join_query_primary_type {
     NON_JOIN_QUERY_PRIMARY_TYPE_SUBEXPRESSION
 } non_join_query_primary_type_t;
 
-typedef struct non_join_query_primary {
+typedef struct non_join_query_primary : pooled_node_t {
     non_join_query_primary_type primary_type;
     non_join_query_primary(
             non_join_query_primary_type_t primary_type) :
         primary_type(primary_type)
     {}
+    virtual ~non_join_query_primary() {}
 } non_join_query_primary_t;
 
 typedef struct query_specification_non_join_query_primary : non_join_query_primary_t {
@@ -81,7 +83,7 @@ typedef struct query_specification_non_join_query_primary : non_join_query_prima
     {}
 } query_specification_non_join_query_primary_t;
 
-typedef struct table_value_constructor {
+typedef struct table_value_constructor : pooled_node_t {
     std::vector<std::unique_ptr<row_value_constructor_t>> values;
     table_value_constructor(
             std::vector<std::unique_ptr<row_value_constructor_t>>& values) :
@@ -98,7 +100,7 @@ typedef struct table_value_constructor_non_join_query_primary : non_join_query_p
     {}
 } table_value_constructor_non_join_query_primary_t;
 
-typedef struct non_join_query_term {
+typedef struct non_join_query_term : pooled_node_t {
     std::unique_ptr<non_join_query_primary_t> primary;
     non_join_query_term(
             std::unique_ptr<non_join_query_primary_t>& primary) :
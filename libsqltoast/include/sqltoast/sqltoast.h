@@ -0,0 +1,399 @@
+// DO NOT EDIT. Only edit the lnclude/sqltoast.h.in file, since sqltoast.h is
+// generated during build.
+#ifndef SQLTOAST_H
+#define SQLTOAST_H
+
+#define SQLTOAST_VERSION_MAJOR 0
+#define SQLTOAST_VERSION_MINOR 1
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SQLTOAST_UNREACHABLE() __builtin_unreachable()
+#else
+#define SQLTOAST_UNREACHABLE() assert(!"code should not be reachable")
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#include "lexeme.h"
+#include "symbol.h"
+#include "token.h"
+#include "node_pool.h"
+#include "identifier.h"
+#include "data_type.h"
+#include "constraint.h"
+#include "column_definition.h"
+#include "value.h"
+#include "value_expression.h"
+#include "column_reference.h"
+#include "predicate.h"
+#include "table_reference.h"
+#include "query.h"
+#include "statement.h"
+
+#include "debug.h"
+
+namespace sqltoast {
+
+// Dialects of SQL that can be parsed by sqltoast
+typedef enum sql_dialect {
+    SQL_DIALECT_ANSI_1992,
+    SQL_DIALECT_ANSI_1999,
+    SQL_DIALECT_ANSI_2003
+} sql_dialect_t;
+
+// Possible return codes from parsing
+enum parse_result_code {
+    PARSE_OK,
+    PARSE_INPUT_ERROR,
+    PARSE_SYNTAX_ERROR
+};
+
+typedef enum error {
+    ERR_NONE,
+    ERR_NO_CLOSING_DELIMITER
+} error_t;
+
+typedef struct parse_options {
+    // The dialect of SQL to parse the input with
+    sql_dialect_t dialect;
+    // If true, sqltoast::parse() will not attempt to create
+    // sqltoast::statement objects during parsing. If all the caller is
+    // interested in is determining whether a particular input is valid SQL and
+    // parses to one or more SQL statements, this can reduce both the CPU time
+    // taken as well as the memory usage of the parser.
+    bool disable_statement_construction;
+    // If true, the input is broken into tokens once, before parsing begins,
+    // instead of as the parser asks for each token. Backtracking by the parser
+    // then never causes the same bytes to be lexed again, at the cost of
+    // memory for an array holding every token in the input. Deeply nested
+    // expressions and search conditions benefit the most from this.
+    bool tokenize_once;
+    // If true, one vectorized pass over the input before parsing begins
+    // indexes every parenthesis, comma and semicolon outside of literals,
+    // delimited identifiers and comments. The parser uses the index to see
+    // where a parenthesized expression ends before parsing it, which saves
+    // it from parsing nested search conditions twice.
+    bool structural_index;
+    // If greater than 1, the input is split into statements at the semicolons
+    // that end them, and the statements are parsed on up to this many
+    // threads. The parse result is the same as when parsing on one thread:
+    // the statements are in input order and, if some statement fails to
+    // parse, the statements before it are returned along with the same error
+    // the serial parser reports. This only pays off for inputs with many
+    // statements, such as migration scripts and dumps. The rows of a long
+    // INSERT ... VALUES list are likewise parsed on up to this many threads.
+    size_t num_threads;
+} parse_options_t;
+
+// The kinds of syntax error the parser reports
+typedef enum syntax_error_code {
+    SYNTAX_ERROR_NONE,
+    // None of the expected symbols was found
+    SYNTAX_ERROR_EXPECTED_SYMBOL,
+    // The token found does not begin or continue the construct described by
+    // the error's description
+    SYNTAX_ERROR_EXPECTED_CONSTRUCT,
+    // A statement was expected, but the token found is not the keyword a
+    // statement begins with
+    SYNTAX_ERROR_EXPECTED_STATEMENT,
+    // The input is invalid for the reason given in the error's description
+    SYNTAX_ERROR_INVALID
+} syntax_error_code_t;
+
+// The most symbols a syntax error lists as expected
+const size_t SYNTAX_ERROR_MAX_EXPECTED = 8;
+
+// A syntax error as recorded by the parser, from which the parse result's
+// error message is built. Recording one is cheap, which matters because the
+// parser records and then discards an error every time it tries one
+// alternative production and falls back to another.
+typedef struct syntax_error {
+    syntax_error_code_t code;
+    // The offset from the start of the input of the token the error was
+    // found at, and the line and column (in bytes) of that offset, both
+    // counting from 1. The line and column are only set once parsing has
+    // failed with this error.
+    size_t offset;
+    size_t line;
+    size_t column;
+    // The token the error was found at. Its lexeme points into the input.
+    token_t found;
+    // The symbols any of which would have been accepted instead of the token
+    // found, when code is SYNTAX_ERROR_EXPECTED_SYMBOL
+    symbol_t expected[SYNTAX_ERROR_MAX_EXPECTED];
+    size_t num_expected;
+    // What was expected, or why the input is invalid, for other codes
+    const char* description;
+    syntax_error() :
+        code(SYNTAX_ERROR_NONE),
+        offset(0),
+        line(0),
+        column(0),
+        found(),
+        num_expected(0),
+        description(nullptr)
+    {}
+} syntax_error_t;
+
+typedef struct parse_result {
+    parse_result_code code;
+    std::string error;
+    // When code is PARSE_SYNTAX_ERROR, the error that error describes
+    syntax_error_t syntax_error;
+    // As each SQL statement in an input stream is successfully parsed, a
+    // sqltoast::statement derived object will be dynamically allocated and
+    // pushed onto this vector
+    std::vector<std::unique_ptr<statement>> statements;
+} parse_result_t;
+
+parse_result_t parse(parse_input_t& subject);
+parse_result_t parse(parse_input_t& subject, parse_options_t &opts);
+
+// Parses the len bytes of SQL starting at subject without copying them. The
+// lexemes in the returned result point directly into the supplied memory,
+// which must outlive the result.
+parse_result_t parse(const char* subject, size_t len);
+parse_result_t parse(const char* subject, size_t len, parse_options_t &opts);
+
+// Called with each statement as soon as it has been parsed. The handler may
+// take ownership of the statement by moving it out of the supplied pointer;
+// otherwise the statement is destroyed when the handler returns. Return false
+// to stop parsing.
+typedef std::function<bool (std::unique_ptr<statement_t>& stmt)> statement_handler_t;
+
+// Parses the supplied input, handing each statement to the handler instead of
+// collecting the statements in the returned result, which is only used to
+// report errors. The handler is not called when statement construction is
+// disabled.
+parse_result_t parse(
+        parse_input_t& subject,
+        parse_options_t& opts,
+        statement_handler_t handler);
+parse_result_t parse(
+        const char* subject,
+        size_t len,
+        parse_options_t& opts,
+        statement_handler_t handler);
+
+#if __cplusplus >= 201703L
+inline parse_result_t parse(std::string_view subject) {
+    return parse(subject.data(), subject.size());
+}
+inline parse_result_t parse(std::string_view subject, parse_options_t &opts) {
+    return parse(subject.data(), subject.size(), opts);
+}
+inline parse_result_t parse(
+        std::string_view subject,
+        parse_options_t &opts,
+        statement_handler_t handler) {
+    return parse(subject.data(), subject.size(), opts, handler);
+}
+#endif
+
+// Parses input that is followed by zero padding. The lexer uses the padding
+// to find the end of words, numbers and runs of whitespace without checking
+// every byte against the end of the input, which is faster for large inputs.
+parse_result_t parse(padded_input_t& subject);
+parse_result_t parse(padded_input_t& subject, parse_options_t &opts);
+
+// One of the independent inputs to parse_batch()
+typedef struct batch_input {
+    const char* subject;
+    size_t len;
+} batch_input_t;
+
+typedef struct batch_result {
+    // The result of parsing each input, in the same order as the inputs
+    std::vector<parse_result_t> results;
+    // The number of threads that parsed the batch
+    size_t num_threads;
+    // The wall-clock time taken to parse the whole batch
+    uint64_t elapsed_ns;
+} batch_result_t;
+
+// Parses each of the supplied inputs independently of the others, spreading
+// them over num_threads threads (or, if num_threads is 0, one per hardware
+// thread). The calling thread is one of them. Each thread starts on its own
+// contiguous share of the inputs and, once that runs out, steals half of
+// whatever remains of the busiest-looking share of another thread, so a few
+// slow inputs don't leave the other threads idle. To only check that the
+// inputs are valid SQL, without building any statements, set
+// disable_statement_construction in the supplied options.
+batch_result_t parse_batch(
+        const batch_input_t* inputs,
+        size_t num_inputs,
+        parse_options_t& opts,
+        size_t num_threads);
+batch_result_t parse_batch(
+        const std::vector<std::string>& inputs,
+        parse_options_t& opts,
+        size_t num_threads);
+
+struct parser_state;
+
+// A parser for parsing many inputs, one after another, that holds on to the
+// memory it allocates between parses: the result's statement vector and error
+// string, along with the lexer's token array when tokenize_once is set. Memory
+// for the statements themselves is recycled by the node pool (see
+// node_pool.h). When num_threads is above 1, statements parsed on other
+// threads are lexed into token arrays of their own, which are not kept. A
+// parser must not be used by more than one thread at a time.
+typedef struct parser {
+    parse_options_t opts;
+    parse_result_t result;
+    std::unique_ptr<parser_state> state;
+    parser();
+    parser(parse_options_t& opts);
+    ~parser();
+    // Parses the supplied input, replacing the result of any previous parse.
+    // The returned result belongs to the parser and remains valid until the
+    // next call to parse() or reset().
+    parse_result_t& parse(const char* subject, size_t len);
+    parse_result_t& parse(parse_input_t& subject);
+    // Destroys the statements from the previous parse and clears any error,
+    // keeping the memory they used for the next parse
+    void reset();
+} parser_t;
+
+// Reads up to len bytes of input into buf, setting *nread to the number of
+// bytes read. Setting *nread to 0 signals the end of the input. Returns false
+// if the input could not be read.
+typedef std::function<bool (char* buf, size_t len, size_t* nread)> stream_reader_t;
+
+// Called by parse_stream() with each statement parsed from the stream. The
+// statement, along with the input its lexemes point into, is destroyed as soon
+// as the handler returns. Return false to stop parsing.
+typedef std::function<bool (const statement_t& stmt)> stream_handler_t;
+
+// The default number of bytes parse_stream() reads from its input at a time
+const size_t STREAM_WINDOW_SIZE = 1 << 20;
+
+typedef struct stream_result {
+    parse_result_code code;
+    // The line and column a syntax error gives are those in the stream, not
+    // in the statement that failed to parse
+    std::string error;
+    // The number of statements handed to the handler
+    size_t statement_count;
+    // When code is not PARSE_OK, the offset in the stream of the statement
+    // (or, for input errors, the read) that failed
+    uint64_t error_offset;
+} stream_result_t;
+
+// Parses SQL read from the supplied reader a window of window_size bytes at a
+// time, handing each statement to the handler as soon as it is parsed. A
+// statement that spans windows is carried over into the next one, so memory
+// use is bounded by the size of the largest statement plus the window size,
+// no matter how large the input is. Parsing stops at the first error.
+stream_result_t parse_stream(
+        stream_reader_t reader,
+        stream_handler_t handler,
+        parse_options_t& opts,
+        size_t window_size);
+// As above, reading from the supplied file descriptor
+stream_result_t parse_stream(
+        int fd,
+        stream_handler_t handler,
+        parse_options_t& opts,
+        size_t window_size);
+stream_result_t parse_stream(int fd, stream_handler_t handler);
+
+// What a push parser is waiting for after being fed some input
+typedef enum push_status {
+    // Every complete statement fed so far has been parsed and handed to the
+    // handler. A statement cut short by the end of the input fed so far is
+    // kept until the rest of it is fed.
+    PUSH_NEED_MORE_INPUT,
+    // finish() was called and all of the input has been parsed
+    PUSH_DONE,
+    // The handler returned false
+    PUSH_STOPPED,
+    // A statement failed to parse. See the parser's result for the error.
+    PUSH_SYNTAX_ERROR,
+    // finish() was called without any input having been fed
+    PUSH_INPUT_ERROR
+} push_status_t;
+
+struct push_parser_state;
+
+// A parser that is fed its input a chunk at a time, as the input arrives from
+// a socket, say, rather than reading it. Each statement is parsed and handed
+// to the handler as soon as the semicolon ending it has been fed, so a
+// statement that arrives in several chunks is never mistaken for a syntax
+// error. Chunks are copied, so they need not outlive the call to feed(). As
+// with parse_stream(), each statement is destroyed as soon as the handler
+// returns. A push parser must not be used by more than one thread at a time.
+typedef struct push_parser {
+    parse_options_t opts;
+    stream_handler_t handler;
+    push_status_t status;
+    // The number of statements handed to the handler and, once parsing has
+    // failed, the error and its offset in the input fed to the parser
+    stream_result_t result;
+    std::unique_ptr<push_parser_state> state;
+    push_parser(stream_handler_t handler);
+    push_parser(parse_options_t& opts, stream_handler_t handler);
+    ~push_parser();
+    // Appends the supplied bytes to the input and parses any statements they
+    // complete. Once the status is anything but PUSH_NEED_MORE_INPUT, does
+    // nothing and returns the status.
+    push_status_t feed(const char* chunk, size_t len);
+#if __cplusplus >= 201703L
+    push_status_t feed(std::string_view chunk) {
+        return feed(chunk.data(), chunk.size());
+    }
+#endif
+    // Signals the end of the input, parsing the last statement, which need
+    // not end with a semicolon
+    push_status_t finish();
+    // Discards any input and result so that the parser can be fed a new
+    // stream, keeping the memory it allocated for the next one
+    void reset();
+} push_parser_t;
+
+// Returns the tokens in the supplied input without parsing them into SQL
+// statements. Tokens are found lazily as the returned range is iterated, so
+// callers that only need tokens (for syntax highlighting or redaction, for
+// example) pay only for lexing. The range refers to the subject, which must
+// outlive it.
+token_range_t tokenize(parse_input_t& subject);
+token_range_t tokenize(const char* subject, size_t len);
+#if __cplusplus >= 201703L
+inline token_range_t tokenize(std::string_view subject) {
+    return tokenize(subject.data(), subject.size());
+}
+#endif
+
+// The bytes of one statement found by split_statements()
+typedef struct statement_range {
+    // The offset of the statement's first byte from the start of the input
+    size_t offset;
+    size_t len;
+} statement_range_t;
+
+// Finds the statements in the supplied input without lexing or parsing them,
+// by looking for the semicolons that end them. Semicolons inside string
+// literals, delimited identifiers and comments are skipped over. Each range
+// excludes the terminating semicolon and any whitespace around the statement,
+// and input that is nothing but whitespace yields no range. The last statement
+// need not end with a semicolon. The ranges are in input order and can be
+// passed to parse() one at a time.
+std::vector<statement_range_t> split_statements(const char* subject, size_t len);
+std::vector<statement_range_t> split_statements(parse_input_t& subject);
+#if __cplusplus >= 201703L
+inline std::vector<statement_range_t> split_statements(std::string_view subject) {
+    return split_statements(subject.data(), subject.size());
+}
+#endif
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_H */
@@ -26,10 +26,11 @@ typedef enum statement_type {
     STATEMENT_TYPE_UPDATE
 } statement_type_t;
 
-typedef struct statement {
+typedef struct statement : pooled_node_t {
     statement_type_t type;
     statement(statement_type_t type) : type(type)
     {}
+    virtual ~statement() {}
 } statement_t;
 
 typedef struct create_schema_statement : statement_t {
@@ -105,11 +106,12 @@ typedef enum alter_table_action_type {
     ALTER_TABLE_ACTION_TYPE_DROP_CONSTRAINT
 } alter_table_action_type_t;
 
-typedef struct alter_table_action {
+typedef struct alter_table_action : pooled_node_t {
     alter_table_action_type_t type;
     alter_table_action(alter_table_action_type_t type) :
         type(type)
     {}
+    virtual ~alter_table_action() {}
 } alter_table_action_t;
 
 typedef struct add_column_action : alter_table_action_t {
@@ -230,7 +232,7 @@ typedef enum set_column_type {
 
 // A set_column_t is a struct representing the column to update in an UPDATE
 // statement along with the value to set the column to
-typedef struct set_column {
+typedef struct set_column : pooled_node_t {
     set_column_type_t type;
     lexeme_t column_name;
     std::unique_ptr<value_expression_t> value;
@@ -312,11 +314,12 @@ typedef enum grant_action_type {
     GRANT_ACTION_TYPE_USAGE
 } grant_action_type_t;
 
-typedef struct grant_action {
+typedef struct grant_action : pooled_node_t {
     grant_action_type_t type;
     grant_action(grant_action_type_t type) :
         type(type)
     {}
+    virtual ~grant_action() {}
 } grant_action_t;
 
 typedef struct column_list_grant_action : grant_action_t {
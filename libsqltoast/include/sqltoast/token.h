@@ -0,0 +1,143 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_TOKEN_H
+#define SQLTOAST_TOKEN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+
+namespace sqltoast {
+
+typedef enum literal_value_type {
+    LITERAL_VALUE_NONE,
+    LITERAL_VALUE_UNSIGNED_INTEGER,
+    LITERAL_VALUE_SIGNED_INTEGER,
+    LITERAL_VALUE_DOUBLE,
+    // The literal is an integer that does not fit in 64 bits
+    LITERAL_VALUE_OVERFLOW
+} literal_value_type_t;
+
+// The value of a numeric literal, decoded by the lexer. Integer literals are
+// decoded exactly. Decimal and approximate numeric literals are decoded to
+// the nearest double.
+typedef struct literal_value {
+    literal_value_type_t type;
+    union {
+        uint64_t uint_value;
+        int64_t int_value;
+        double double_value;
+    };
+    literal_value() :
+        type(LITERAL_VALUE_NONE),
+        uint_value(0)
+    {}
+} literal_value_t;
+
+typedef struct token {
+    symbol_t symbol;
+    lexeme_t lexeme;
+    // Only set for numeric literal tokens
+    literal_value_t value;
+    token() :
+        symbol(SYMBOL_NONE),
+        lexeme(),
+        value()
+    {}
+    token(
+        symbol_t symbol,
+        parse_position_t start,
+        parse_position_t end) :
+        symbol(symbol), lexeme(start, end), value()
+    {}
+    inline bool is_literal() const {
+        return (symbol >= SYMBOL_LITERAL_APPROXIMATE_NUMBER && symbol <= SYMBOL_LITERAL_UNSIGNED_INTEGER);
+    }
+    inline bool is_punctuator() const {
+        return (symbol >= SYMBOL_ASTERISK && symbol <= SYMBOL_VERTICAL_BAR);
+    }
+    inline bool is_keyword() const {
+        return (symbol >= SYMBOL_ALL && symbol <= SYMBOL_VARYING);
+    }
+    inline bool is_identifier() const {
+        return (symbol == SYMBOL_IDENTIFIER);
+    }
+} token_t;
+
+std::ostream& operator<< (std::ostream& out, const token_t& token);
+
+// Iterates over the tokens in some input, lexing each token only when the
+// iterator is advanced to it. Whitespace and simple (--) comments are skipped
+// over. Bracketed (/* */) comments are produced as SYMBOL_COMMENT tokens.
+//
+// If a byte cannot start any token, or a quoted string or delimited
+// identifier has no closing delimiter, a SYMBOL_ERROR token is produced for
+// the offending bytes and iteration continues after them.
+//
+// An iterator that has reached the end of the input compares equal to a
+// default-constructed token_iterator_t.
+typedef struct token_iterator {
+    typedef std::input_iterator_tag iterator_category;
+    typedef token_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const token_t* pointer;
+    typedef const token_t& reference;
+
+    parse_position_t cursor;
+    parse_position_t end;
+    token_t token;
+    token_iterator() :
+        cursor(),
+        end(),
+        token(SYMBOL_EOS, parse_position_t(), parse_position_t())
+    {}
+    // Returns an iterator positioned at the first token in [start, end)
+    token_iterator(parse_position_t start, parse_position_t end);
+    inline reference operator*() const {
+        return token;
+    }
+    inline pointer operator->() const {
+        return &token;
+    }
+    // Advances the iterator to the next token in the input
+    token_iterator& operator++();
+    inline token_iterator operator++(int) {
+        token_iterator before(*this);
+        ++(*this);
+        return before;
+    }
+    inline bool operator==(const token_iterator& other) const {
+        if (token.symbol == SYMBOL_EOS || other.token.symbol == SYMBOL_EOS)
+            return token.symbol == other.token.symbol;
+        return cursor == other.cursor;
+    }
+    inline bool operator!=(const token_iterator& other) const {
+        return ! (*this == other);
+    }
+} token_iterator_t;
+
+// The tokens in some input, for use with range-based for loops and standard
+// algorithms
+typedef struct token_range {
+    parse_position_t input_start;
+    parse_position_t input_end;
+    token_range(parse_position_t start, parse_position_t end) :
+        input_start(start),
+        input_end(end)
+    {}
+    inline token_iterator_t begin() const {
+        return token_iterator_t(input_start, input_end);
+    }
+    inline token_iterator_t end() const {
+        return token_iterator_t();
+    }
+} token_range_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_TOKEN_H */
@@ -21,7 +21,7 @@ typedef enum vep_type {
     VEP_TYPE_CAST_SPECIFICATION
 } vep_type_t;
 
-typedef struct value_expression_primary {
+typedef struct value_expression_primary : pooled_node_t {
     vep_type_t vep_type;
     lexeme_t lexeme;
     value_expression_primary(
@@ -30,6 +30,7 @@ typedef struct value_expression_primary {
         vep_type(vep_type),
         lexeme(lexeme)
     {}
+    virtual ~value_expression_primary() {}
 } value_expression_primary_t;
 
 // unsigned value specifications are unsigned numeric literals, string and
@@ -54,11 +55,22 @@ typedef enum uvs_type {
 
 typedef struct unsigned_value_specification : value_expression_primary_t {
     uvs_type_t uvs_type;
+    // For numeric literals, the value of the literal decoded by the lexer
+    literal_value_t value;
     unsigned_value_specification(
             uvs_type_t uvs_type,
             lexeme_t lexeme) :
         value_expression_primary_t(VEP_TYPE_UNSIGNED_VALUE_SPECIFICATION, lexeme),
-        uvs_type(uvs_type)
+        uvs_type(uvs_type),
+        value()
+    {}
+    unsigned_value_specification(
+            uvs_type_t uvs_type,
+            lexeme_t lexeme,
+            const literal_value_t& value) :
+        value_expression_primary_t(VEP_TYPE_UNSIGNED_VALUE_SPECIFICATION, lexeme),
+        uvs_type(uvs_type),
+        value(value)
     {}
 } unsigned_value_specification_t;
 
@@ -105,6 +117,7 @@ typedef struct case_expression : value_expression_primary_t {
         value_expression_primary_t(VEP_TYPE_CASE_EXPRESSION, lexeme),
         case_type(case_type)
     {}
+    virtual ~case_expression() {}
 } case_expression_t;
 
 typedef struct coalesce_function : case_expression_t {
@@ -130,7 +143,7 @@ typedef struct nullif_function : case_expression_t {
     {}
 } nullif_function_t;
 
-typedef struct simple_case_expression_when_clause {
+typedef struct simple_case_expression_when_clause : pooled_node_t {
     std::unique_ptr<struct value_expression> operand;
     std::unique_ptr<struct value_expression> result;
     simple_case_expression_when_clause(
@@ -166,7 +179,7 @@ typedef struct simple_case_expression : case_expression_t {
 } simple_case_expression_t;
 
 struct search_condition;
-typedef struct searched_case_expression_when_clause {
+typedef struct searched_case_expression_when_clause : pooled_node_t {
     std::unique_ptr<struct search_condition> condition;
     std::unique_ptr<struct value_expression> result;
     searched_case_expression_when_clause(
@@ -225,11 +238,12 @@ typedef enum numeric_primary_type {
     NUMERIC_PRIMARY_TYPE_FUNCTION
 } numeric_primary_type_t;
 
-typedef struct numeric_primary {
+typedef struct numeric_primary : pooled_node_t {
     numeric_primary_type_t type;
     numeric_primary(numeric_primary_type_t type) :
         type(type)
     {}
+    virtual ~numeric_primary() {}
 } numeric_primary_t;
 
 typedef struct numeric_value : numeric_primary_t {
@@ -254,6 +268,7 @@ typedef struct numeric_function : numeric_primary_t {
         numeric_primary_t(NUMERIC_PRIMARY_TYPE_FUNCTION),
         type(type)
     {}
+    virtual ~numeric_function() {}
 } numeric_function_t;
 
 typedef struct position_expression : numeric_function_t {
@@ -295,7 +310,7 @@ typedef struct length_expression : numeric_function_t {
     {}
 } length_expression_t;
 
-typedef struct numeric_factor {
+typedef struct numeric_factor : pooled_node_t {
     int8_t sign;
     std::unique_ptr<numeric_primary_t> primary;
     numeric_factor(std::unique_ptr<numeric_primary_t>& primary, int8_t sign) :
@@ -312,7 +327,7 @@ typedef enum numeric_op {
     NUMERIC_OP_DIVIDE
 } numeric_op_t;
 
-typedef struct numeric_term {
+typedef struct numeric_term : pooled_node_t {
     std::unique_ptr<numeric_factor_t> left;
     numeric_op_t op;
     std::unique_ptr<numeric_factor_t> right;
@@ -340,7 +355,7 @@ typedef enum string_function_type {
 } string_function_type_t;
 
 struct value_expression;
-typedef struct string_function {
+typedef struct string_function : pooled_node_t {
     string_function_type_t type;
     // Guaranteed to be static_castable to a character_value_expression_t
     std::unique_ptr<struct value_expression> operand;
@@ -350,6 +365,7 @@ typedef struct string_function {
         type(type),
         operand(std::move(operand))
     {}
+    virtual ~string_function() {}
 } string_function_t;
 
 typedef struct substring_function : string_function_t {
@@ -414,7 +430,7 @@ typedef struct trim_function : string_function_t {
 } trim_function_t;
 
 // A character primary is a value expression primary or a string value function
-typedef struct character_primary {
+typedef struct character_primary : pooled_node_t {
     std::unique_ptr<value_expression_primary_t> value;
     std::unique_ptr<string_function_t> string_function;
     character_primary(
@@ -428,7 +444,7 @@ typedef struct character_primary {
 } character_primary_t;
 
 // A character factor is a character primary with an optional collation.
-typedef struct character_factor {
+typedef struct character_factor : pooled_node_t {
     std::unique_ptr<character_primary_t> primary;
     lexeme_t collation;
     character_factor(
@@ -446,11 +462,12 @@ typedef enum datetime_primary_type {
     DATETIME_PRIMARY_TYPE_FUNCTION
 } datetime_primary_type_t;
 
-typedef struct datetime_primary {
+typedef struct datetime_primary : pooled_node_t {
     datetime_primary_type_t type;
     datetime_primary(datetime_primary_type_t type) :
         type(type)
     {}
+    virtual ~datetime_primary() {}
 } datetime_primary_t;
 
 typedef struct datetime_value : datetime_primary_t {
@@ -473,6 +490,7 @@ typedef struct datetime_function : datetime_primary_t {
         datetime_primary_t(DATETIME_PRIMARY_TYPE_FUNCTION),
         func_type(func_type)
     {}
+    virtual ~datetime_function() {}
 } datetime_function_t;
 
 typedef struct current_datetime_function : datetime_function_t {
@@ -487,7 +505,7 @@ typedef struct current_datetime_function : datetime_function_t {
 
 // A datetime factor evaluates to a datetime value. It contains a datetime
 // primary and has an optional timezone component.
-typedef struct datetime_factor {
+typedef struct datetime_factor : pooled_node_t {
     std::unique_ptr<datetime_primary_t> primary;
     lexeme_t tz;
     datetime_factor(
@@ -501,14 +519,14 @@ typedef struct datetime_factor {
     }
 } datetime_factor_t;
 
-typedef struct datetime_term {
+typedef struct datetime_term : pooled_node_t {
     std::unique_ptr<datetime_factor_t> value;
     datetime_term(std::unique_ptr<datetime_factor_t>& value) :
         value(std::move(value))
     {}
 } datetime_term_t;
 
-typedef struct datetime_field {
+typedef struct datetime_field : pooled_node_t {
     interval_unit_t interval;
     size_t precision;
     size_t fractional_precision;
@@ -522,7 +540,7 @@ typedef struct datetime_field {
     {}
 } datetime_field_t;
 
-typedef struct interval_qualifier {
+typedef struct interval_qualifier : pooled_node_t {
     datetime_field_t start;
     std::unique_ptr<datetime_field_t> end;
     interval_qualifier(
@@ -543,7 +561,7 @@ typedef struct interval_qualifier {
     {}
 } interval_qualifier_t;
 
-typedef struct interval_primary {
+typedef struct interval_primary : pooled_node_t {
     std::unique_ptr<value_expression_primary_t> value;
     std::unique_ptr<interval_qualifier_t> qualifier;
     interval_primary(
@@ -554,7 +572,7 @@ typedef struct interval_primary {
     {}
 } interval_primary_t;
 
-typedef struct interval_factor {
+typedef struct interval_factor : pooled_node_t {
     int8_t sign;
     std::unique_ptr<interval_primary_t> primary;
     interval_factor(
@@ -565,7 +583,7 @@ typedef struct interval_factor {
     {}
 } interval_factor_t;
 
-typedef struct interval_term {
+typedef struct interval_term : pooled_node_t {
     std::unique_ptr<interval_factor_t> left;
     // Operating on an interval term with a numeric factor results in an
     // interval term
@@ -22,11 +22,12 @@ typedef enum value_expression_type {
     VALUE_EXPRESSION_TYPE_INTERVAL_EXPRESSION,
 } value_expression_type_t;
 
-typedef struct value_expression {
+typedef struct value_expression : pooled_node_t {
     value_expression_type_t type;
     value_expression(value_expression_type_t ve_type) :
         type(ve_type)
     {}
+    virtual ~value_expression() {}
 } value_expression_t;
 
 // A numeric value expression is a series of value expressions and literals
@@ -133,10 +134,11 @@ typedef enum rvc_type {
 // lists deduce to multiple values. Examples of where row-value constructors
 // can be found in the SQL grammar include either or both sides of a predicate
 // expression or the contents of the VALUES clause
-typedef struct row_value_constructor {
+typedef struct row_value_constructor : pooled_node_t {
     rvc_type_t rvc_type;
     row_value_constructor(rvc_type_t rvc_type) : rvc_type(rvc_type)
     {}
+    virtual ~row_value_constructor() {}
 } row_value_constructor_t;
 
 typedef enum rvc_element_type {
@@ -152,6 +154,7 @@ typedef struct row_value_constructor_element : row_value_constructor_t {
         row_value_constructor_t(RVC_TYPE_ELEMENT),
         rvc_element_type(rvc_element_type)
     {}
+    virtual ~row_value_constructor_element() {}
 } row_value_constructor_element_t;
 
 typedef struct row_value_expression : row_value_constructor_element_t {
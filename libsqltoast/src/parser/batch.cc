@@ -0,0 +1,160 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/batch.h"
+
+namespace sqltoast {
+
+// The items a worker has yet to work on, as a range of indexes into the
+// batch. The owning worker takes items one at a time from the front, while
+// other workers steal from the back.
+typedef struct batch_share {
+    std::mutex mutex;
+    size_t begin;
+    size_t end;
+    batch_share() :
+        begin(0),
+        end(0)
+    {}
+} batch_share_t;
+
+typedef struct batch_context {
+    const std::function<void (size_t index)>& work;
+    std::vector<batch_share_t> shares;
+    batch_context(
+            const std::function<void (size_t index)>& work,
+            size_t num_workers) :
+        work(work),
+        shares(num_workers)
+    {}
+} batch_context_t;
+
+// Takes the next item from the front of the supplied share. Returns false if
+// the share is empty.
+static bool take_item(batch_share_t& share, size_t* index) {
+    std::lock_guard<std::mutex> lock(share.mutex);
+    if (share.begin == share.end)
+        return false;
+    *index = share.begin++;
+    return true;
+}
+
+// Moves the back half of the largest share belonging to another worker into
+// the supplied worker's share. Returns false if there was nothing to steal.
+static bool steal_items(batch_context_t& ctx, size_t worker) {
+    const size_t num_workers = ctx.shares.size();
+    for (;;) {
+        // Each share is only locked while its size is read, so the sizes are
+        // just a hint as to which worker has the most left to do
+        size_t victim = num_workers;
+        size_t most = 0;
+        for (size_t x = 1; x < num_workers; x++) {
+            size_t candidate = (worker + x) % num_workers;
+            batch_share_t& share = ctx.shares[candidate];
+            std::lock_guard<std::mutex> lock(share.mutex);
+            size_t remaining = share.end - share.begin;
+            if (remaining > most) {
+                most = remaining;
+                victim = candidate;
+            }
+        }
+        if (victim == num_workers)
+            return false;
+
+        size_t begin, end;
+        {
+            batch_share_t& share = ctx.shares[victim];
+            std::lock_guard<std::mutex> lock(share.mutex);
+            size_t remaining = share.end - share.begin;
+            if (remaining == 0)
+                // Someone got there first. Look again.
+                continue;
+            end = share.end;
+            share.end -= (remaining + 1) / 2;
+            begin = share.end;
+        }
+        batch_share_t& own = ctx.shares[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+}
+
+static void run_worker(batch_context_t& ctx, size_t worker) {
+    size_t index;
+    for (;;) {
+        while (take_item(ctx.shares[worker], &index))
+            ctx.work(index);
+        if (! steal_items(ctx, worker))
+            return;
+    }
+}
+
+size_t run_batch(
+        size_t num_items,
+        size_t num_threads,
+        const std::function<void (size_t index)>& work) {
+    if (num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (num_threads > num_items)
+        num_threads = std::max(num_items, static_cast<size_t>(1));
+
+    // Start each worker off with an equal, contiguous share of the items
+    batch_context_t ctx(work, num_threads);
+    for (size_t x = 0; x < num_threads; x++) {
+        ctx.shares[x].begin = (num_items * x) / num_threads;
+        ctx.shares[x].end = (num_items * (x + 1)) / num_threads;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t x = 1; x < num_threads; x++)
+        threads.emplace_back(run_worker, std::ref(ctx), x);
+    run_worker(ctx, 0);
+    for (auto& t : threads)
+        t.join();
+    return num_threads;
+}
+
+batch_result_t parse_batch(
+        const batch_input_t* inputs,
+        size_t num_inputs,
+        parse_options_t& opts,
+        size_t num_threads) {
+    auto start = std::chrono::steady_clock::now();
+    batch_result_t res;
+    res.results.resize(num_inputs);
+    res.num_threads = run_batch(num_inputs, num_threads,
+            [&](size_t index) {
+                const batch_input_t& in = inputs[index];
+                res.results[index] = parse(in.subject, in.len, opts);
+            });
+    res.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+batch_result_t parse_batch(
+        const std::vector<std::string>& inputs,
+        parse_options_t& opts,
+        size_t num_threads) {
+    std::vector<batch_input_t> batch_inputs;
+    batch_inputs.reserve(inputs.size());
+    for (const std::string& in : inputs)
+        batch_inputs.push_back(batch_input_t{in.data(), in.size()});
+    return parse_batch(batch_inputs.data(), batch_inputs.size(), opts,
+            num_threads);
+}
+
+} // namespace sqltoast
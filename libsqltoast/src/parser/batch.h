@@ -0,0 +1,28 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_BATCH_H
+#define SQLTOAST_PARSER_BATCH_H
+
+#include <cstddef>
+#include <functional>
+
+namespace sqltoast {
+
+// Calls work() with each index in [0, num_items), spreading the calls over
+// num_threads threads (or, if num_threads is 0, one per hardware thread),
+// including the calling thread. Each thread starts on its own contiguous
+// share of the indexes and, once that runs out, steals half of whatever
+// remains of the largest share of another thread. Returns the number of
+// threads used.
+size_t run_batch(
+        size_t num_items,
+        size_t num_threads,
+        const std::function<void (size_t index)>& work);
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_BATCH_H */
@@ -0,0 +1,100 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_CHAR_CLASS_H
+#define SQLTOAST_PARSER_CHAR_CLASS_H
+
+#include <cstdint>
+
+namespace sqltoast {
+
+// Byte classification for the lexer. Unlike the <cctype> functions, these do
+// not depend on the process' locale, are safe to call with any char value and
+// compile down to a single table load and mask.
+//
+// Bytes with the high bit set are never whitespace, digits or letters, but
+// they are word and identifier bytes. This way the bytes of a UTF-8 encoded
+// character can appear anywhere in a non-delimited identifier. Keywords are
+// ASCII only, so a word containing such bytes is always an identifier.
+typedef enum char_class {
+    CHAR_CLASS_SPACE = 0x01,
+    CHAR_CLASS_DIGIT = 0x02,
+    CHAR_CLASS_ALPHA = 0x04,
+    CHAR_CLASS_XDIGIT = 0x08,
+    // Bytes that make up a keyword or the name part of an identifier
+    CHAR_CLASS_WORD = 0x10,
+    // Bytes that may appear in a non-delimited identifier after its first
+    // byte. Includes the period separating object names and the asterisk in
+    // "t1.*".
+    CHAR_CLASS_IDENTIFIER = 0x20
+} char_class_t;
+
+typedef struct char_class_table {
+    uint8_t classes[256];
+} char_class_table_t;
+
+constexpr char_class_table_t build_char_class_table() {
+    char_class_table_t t = {};
+    // \t, \n, \v, \f, \r and the space character
+    for (int c = '\t'; c <= '\r'; c++)
+        t.classes[c] |= CHAR_CLASS_SPACE;
+    t.classes[static_cast<uint8_t>(' ')] |= CHAR_CLASS_SPACE;
+    for (int c = '0'; c <= '9'; c++)
+        t.classes[c] |= CHAR_CLASS_DIGIT | CHAR_CLASS_XDIGIT |
+            CHAR_CLASS_WORD | CHAR_CLASS_IDENTIFIER;
+    for (int c = 'a'; c <= 'z'; c++) {
+        const int upper = c - 'a' + 'A';
+        t.classes[c] |= CHAR_CLASS_ALPHA | CHAR_CLASS_WORD |
+            CHAR_CLASS_IDENTIFIER;
+        t.classes[upper] |= CHAR_CLASS_ALPHA | CHAR_CLASS_WORD |
+            CHAR_CLASS_IDENTIFIER;
+        if (c <= 'f') {
+            t.classes[c] |= CHAR_CLASS_XDIGIT;
+            t.classes[upper] |= CHAR_CLASS_XDIGIT;
+        }
+    }
+    t.classes[static_cast<uint8_t>('_')] |= CHAR_CLASS_WORD |
+        CHAR_CLASS_IDENTIFIER;
+    for (int c = 0x80; c <= 0xFF; c++)
+        t.classes[c] |= CHAR_CLASS_WORD | CHAR_CLASS_IDENTIFIER;
+    t.classes[static_cast<uint8_t>('.')] |= CHAR_CLASS_IDENTIFIER;
+    t.classes[static_cast<uint8_t>('*')] |= CHAR_CLASS_IDENTIFIER;
+    return t;
+}
+
+constexpr char_class_table_t char_classes = build_char_class_table();
+
+inline bool char_is(const char c, const char_class_t cls) {
+    return (char_classes.classes[static_cast<uint8_t>(c)] & cls) != 0;
+}
+
+inline bool char_is_space(const char c) {
+    return char_is(c, CHAR_CLASS_SPACE);
+}
+
+inline bool char_is_digit(const char c) {
+    return char_is(c, CHAR_CLASS_DIGIT);
+}
+
+inline bool char_is_alpha(const char c) {
+    return char_is(c, CHAR_CLASS_ALPHA);
+}
+
+inline bool char_is_xdigit(const char c) {
+    return char_is(c, CHAR_CLASS_XDIGIT);
+}
+
+inline bool char_is_word(const char c) {
+    return char_is(c, CHAR_CLASS_WORD);
+}
+
+inline bool char_is_identifier(const char c) {
+    return char_is(c, CHAR_CLASS_IDENTIFIER);
+}
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_CHAR_CLASS_H */
@@ -397,19 +397,11 @@ err_expect_update_or_delete:
     expect_any_error(ctx, {SYMBOL_UPDATE, SYMBOL_DELETE});
     return false;
 err_already_found_on_update:
-    {
-        std::stringstream estr;
-        estr << "Already found ON UPDATE constraint." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    invalid_syntax_error(ctx, "Already found ON UPDATE constraint.");
+    return false;
 err_already_found_on_delete:
-    {
-        std::stringstream estr;
-        estr << "Already found ON DELETE constraint." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    invalid_syntax_error(ctx, "Already found ON DELETE constraint.");
+    return false;
 push_constraint:
     if (ctx.opts.disable_statement_construction)
         return true;
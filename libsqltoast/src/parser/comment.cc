@@ -7,6 +7,7 @@
 #include "sqltoast/sqltoast.h"
 
 #include "parser/comment.h"
+#include "parser/scan.h"
 
 namespace sqltoast {
 
@@ -36,22 +37,22 @@ tokenize_result_t token_comment(
         parse_position_t cursor,
         const parse_position_t end) {
     parse_position_t start = cursor;
-    if (*cursor != '/')
-        return tokenize_result_t(TOKEN_NOT_FOUND);
-
-    cursor++;
-    if (*cursor != '*')
+    if ((end - cursor) < 2 || *cursor != '/' || *(cursor + 1) != '*')
         return tokenize_result_t(TOKEN_NOT_FOUND);
 
     // OK, we found the start of a comment. Run through the subject until we
-    // find the closing */ marker
-    do {
-        cursor++;
-        if (cursor == end || (cursor + 1) == end) {
-            return tokenize_result_t(TOKEN_ERR_NO_CLOSING_DELIMITER, start, cursor);
-        }
-    } while (*cursor != '*' || *(cursor + 1) != '/');
-    return tokenize_result_t(SYMBOL_COMMENT, start, cursor + 1);
+    // find the closing */ marker, jumping from asterisk to asterisk
+    const char* opener = &*cursor;
+    const char* stop = opener + (end - cursor);
+    const char* p = opener + 2;
+    for (;;) {
+        p = scan_find_byte(p, stop, '*');
+        if ((stop - p) < 2)
+            return tokenize_result_t(TOKEN_ERR_NO_CLOSING_DELIMITER, start, end);
+        if (*(p + 1) == '/')
+            return tokenize_result_t(SYMBOL_COMMENT, start, cursor + (p + 2 - opener));
+        p++;
+    }
 }
 
 } // namespace sqltoast
@@ -10,6 +10,8 @@
 #include "sqltoast/sqltoast.h"
 
 #include "parser/lexer.h"
+#include "parser/lines.h"
+#include "parser/structure.h"
 #include "parser/token.h"
 
 namespace sqltoast {
@@ -18,10 +20,34 @@ typedef struct parse_context {
     parse_result_t& result;
     parse_options_t& opts;
     lexer_t lexer;
-    parse_context(parse_result_t& result, parse_options_t& opts, parse_input_t& subject) :
+    // Built before parsing when opts.structural_index is set, and otherwise
+    // empty
+    structural_index_t structure;
+    // Built the first time the line of some position in the input is needed
+    line_index_t lines;
+    // Where the input begins in the larger input it was cut from, so that
+    // syntax errors give the line and column in the larger input
+    line_origin_t origin;
+    // When not NULL, each parsed statement is handed to this handler instead
+    // of being added to the result's statements
+    statement_handler_t* handler;
+    // Set when the handler asks for parsing to stop
+    bool stopped;
+    parse_context(
+            parse_result_t& result,
+            parse_options_t& opts,
+            parse_position_t start,
+            parse_position_t end,
+            bool padded,
+            statement_handler_t* handler) :
         result(result),
         opts(opts),
-        lexer(subject)
+        lexer(start, end, padded),
+        structure(),
+        lines(),
+        origin(),
+        handler(handler),
+        stopped(false)
     {}
 } parse_context_t;
 
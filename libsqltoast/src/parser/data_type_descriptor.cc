@@ -4,7 +4,8 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <sstream>
+#include <cstdint>
+#include <string>
 
 #include "sqltoast/sqltoast.h"
 
@@ -14,6 +15,24 @@
 
 namespace sqltoast {
 
+// Sets the supplied size to the value the lexer decoded for the supplied
+// unsigned integer literal token. Returns false if the value does not fit.
+static inline bool literal_to_size(const token_t& tok, size_t* out) {
+    const literal_value_t& val = tok.value;
+    if (val.type != LITERAL_VALUE_UNSIGNED_INTEGER || val.uint_value > SIZE_MAX)
+        return false;
+    *out = static_cast<size_t>(val.uint_value);
+    return true;
+}
+
+static void size_too_large_error(parse_context_t& ctx) {
+    // The error only points at its description, so it must live on
+    static const std::string description =
+        "Expected an unsigned integer no larger than " +
+        std::to_string(SIZE_MAX);
+    expect_construct_error(ctx, description.c_str());
+}
+
 // <data type> ::=
 //     <character string type> [ CHARACTER SET <character set specification> ]
 //     | <national character string type>
@@ -52,10 +71,7 @@ bool parse_data_type_descriptor(
     if (parse_interval(ctx, cur_tok, out))
         return true;
     {
-        std::stringstream estr;
-        estr << "Expected data type after <column name> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx, "Expected data type after <column name>");
         return false;
     }
 }
@@ -255,8 +271,8 @@ bool parse_length_specifier(
         cur_sym = cur_tok.symbol;
         if (cur_sym != SYMBOL_LITERAL_UNSIGNED_INTEGER)
             goto err_expect_size_literal;
-        const std::string len_str(cur_tok.lexeme.start, cur_tok.lexeme.end);
-        *out = atoi(len_str.data());
+        if (! literal_to_size(cur_tok, out))
+            goto err_size_too_large;
         cur_tok = lex.next();
         return true;
     }
@@ -264,6 +280,9 @@ bool parse_length_specifier(
 err_expect_size_literal:
     expect_error(ctx, SYMBOL_LITERAL_UNSIGNED_INTEGER);
     return false;
+err_size_too_large:
+    size_too_large_error(ctx);
+    return false;
 }
 
 // <exact numeric type> ::=
@@ -343,8 +362,8 @@ process_precision:
         cur_sym = cur_tok.symbol;
         if (cur_sym != SYMBOL_LITERAL_UNSIGNED_INTEGER)
             goto err_expect_uint_literal;
-        const std::string prec_str(cur_tok.lexeme.start, cur_tok.lexeme.end);
-        *out_precision = atoi(prec_str.data());
+        if (! literal_to_size(cur_tok, out_precision))
+            goto err_size_too_large;
         cur_tok = lex.next();
         goto optional_scale;
     }
@@ -352,6 +371,9 @@ process_precision:
 err_expect_uint_literal:
     expect_error(ctx, SYMBOL_LITERAL_UNSIGNED_INTEGER);
     return false;
+err_size_too_large:
+    size_too_large_error(ctx);
+    return false;
 optional_scale:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
@@ -368,8 +390,8 @@ process_scale:
         cur_sym = cur_tok.symbol;
         if (cur_sym != SYMBOL_LITERAL_UNSIGNED_INTEGER)
             goto err_expect_uint_literal;
-        const std::string scale_str(cur_tok.lexeme.start, cur_tok.lexeme.end);
-        *out_scale = atoi(scale_str.data());
+        if (! literal_to_size(cur_tok, out_scale))
+            goto err_size_too_large;
         cur_tok = lex.next();
         goto precision_close;
     }
@@ -13,48 +13,153 @@
 
 namespace sqltoast {
 
-// TODO(jaypipes): Limit the amount of output to something like 200 characters
-// before the syntax error position...
-void create_syntax_error_marker(parse_context_t& ctx, std::stringstream& es) {
+static inline syntax_error_t& record_syntax_error(
+        parse_context_t& ctx,
+        syntax_error_code_t code) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t err_pos = lex.current_token.lexeme.start;
-    std::string original(lex.start, lex.end);
-    std::string location(original);
-    auto start_pos = err_pos - lex.start;
-    for (auto cur = location.begin(); cur != location.end(); cur++) {
-        auto loc_pos = cur - location.begin() + 1;
-        if (loc_pos < start_pos) {
-            *cur = ' ';
-        } else {
-            *cur = '^';
-        }
-    }
-
-    es << original << std::endl << location;
-    ctx.result.error.assign(es.str());
+    syntax_error_t& err = ctx.result.syntax_error;
+    err.code = code;
+    err.found = lex.current_token;
+    err.offset = lex.current_token.lexeme.start - lex.start;
+    err.num_expected = 0;
+    err.description = nullptr;
     ctx.result.code = PARSE_SYNTAX_ERROR;
+    return err;
 }
 
 void expect_error(parse_context_t& ctx, symbol_t expected) {
-    std::stringstream es;
-    es << "Expected to find " << expected
-        << " but found " << ctx.lexer.current_token << std::endl;
-    create_syntax_error_marker(ctx, es);
+    syntax_error_t& err = record_syntax_error(ctx,
+            SYNTAX_ERROR_EXPECTED_SYMBOL);
+    err.expected[0] = expected;
+    err.num_expected = 1;
 }
 
 void expect_any_error(parse_context_t& ctx, std::initializer_list<symbol_t> expected) {
-    std::stringstream es;
-    es << "Expected to find one of (";
-    size_t num_expected = expected.size();
-    size_t x = 0;
+    syntax_error_t& err = record_syntax_error(ctx,
+            SYNTAX_ERROR_EXPECTED_SYMBOL);
     for (auto exp_sym : expected) {
-        es << exp_sym;
-        if ((x + 1) < num_expected)
-            es << "|";
-        x++;
+        if (err.num_expected == SYNTAX_ERROR_MAX_EXPECTED)
+            break;
+        err.expected[err.num_expected++] = exp_sym;
+    }
+}
+
+void expect_construct_error(parse_context_t& ctx, const char* description) {
+    syntax_error_t& err = record_syntax_error(ctx,
+            SYNTAX_ERROR_EXPECTED_CONSTRUCT);
+    err.description = description;
+}
+
+void expect_statement_error(parse_context_t& ctx) {
+    record_syntax_error(ctx, SYNTAX_ERROR_EXPECTED_STATEMENT);
+}
+
+void invalid_syntax_error(parse_context_t& ctx, const char* description) {
+    syntax_error_t& err = record_syntax_error(ctx, SYNTAX_ERROR_INVALID);
+    err.description = description;
+}
+
+void clear_syntax_error(parse_context_t& ctx) {
+    ctx.result.code = PARSE_OK;
+    ctx.result.syntax_error.code = SYNTAX_ERROR_NONE;
+}
+
+// Describes the error token the parser found, if it is one the lexer produced
+// for a string literal, delimited identifier or comment that is never closed.
+// Such a token begins with its opening delimiter and runs to the end of the
+// input.
+static const char* describe_error_token(const token_t& tok) {
+    if (tok.symbol != SYMBOL_ERROR || tok.lexeme.start == tok.lexeme.end)
+        return nullptr;
+    switch (*tok.lexeme.start) {
+        case '\'':
+            return "Unterminated character string literal";
+        case '"':
+        case '`':
+            return "Unterminated delimited identifier";
+        case '/':
+            return "Unterminated comment";
+        default:
+            return nullptr;
     }
-    es << ") but found " << ctx.lexer.current_token << std::endl;
-    create_syntax_error_marker(ctx, es);
+}
+
+void render_syntax_error(parse_context_t& ctx) {
+    lexer_t& lex = ctx.lexer;
+    line_index_t& lines = ctx.lines;
+    syntax_error_t& err = ctx.result.syntax_error;
+    std::stringstream es;
+    // Whatever the parser expected, the input is wrong because the lexer
+    // could not tokenize it, so that is what we report
+    const char* lex_error = describe_error_token(err.found);
+    if (err.code != SYNTAX_ERROR_NONE && lex_error != nullptr) {
+        es << lex_error << std::endl;
+        goto print_context;
+    }
+    switch (err.code) {
+        case SYNTAX_ERROR_EXPECTED_SYMBOL:
+            if (err.num_expected == 1) {
+                es << "Expected to find " << err.expected[0];
+            } else {
+                es << "Expected to find one of (";
+                for (size_t x = 0; x < err.num_expected; x++) {
+                    es << err.expected[x];
+                    if ((x + 1) < err.num_expected)
+                        es << "|";
+                }
+                es << ")";
+            }
+            es << " but found " << err.found << std::endl;
+            break;
+        case SYNTAX_ERROR_EXPECTED_CONSTRUCT:
+            es << err.description << " but found " << err.found << std::endl;
+            break;
+        case SYNTAX_ERROR_EXPECTED_STATEMENT:
+            es << "SQL statements begin with a keyword and end with a "
+                  "semicolon, but found " << err.found << "." << std::endl;
+            break;
+        case SYNTAX_ERROR_INVALID:
+            es << err.description << std::endl;
+            break;
+        default:
+            return;
+    }
+
+print_context:
+    if (lines.empty())
+        lines.build(lex.start, lex.end);
+    const size_t line = lines.line(err.offset);
+    const size_t line_start = lines.line_start(line);
+    const size_t line_end = lines.line_end(line);
+    err.line = ctx.origin.line + line - 1;
+    err.column = err.offset - line_start + 1;
+    if (line == 1)
+        err.column += ctx.origin.column - 1;
+    if (err.line > 1 || ! lines.newlines.empty())
+        es << "Line " << err.line << ", column " << err.column << ":"
+           << std::endl;
+
+    // Show no more of the error's line than the context window, so that an
+    // error in a huge single-line input doesn't produce a huge message
+    size_t ctx_start = line_start;
+    if ((err.offset - ctx_start) > SYNTAX_ERROR_CONTEXT_BEFORE)
+        ctx_start = err.offset - SYNTAX_ERROR_CONTEXT_BEFORE;
+    size_t ctx_end = line_end;
+    if ((ctx_end - err.offset) > SYNTAX_ERROR_CONTEXT_AFTER)
+        ctx_end = err.offset + SYNTAX_ERROR_CONTEXT_AFTER;
+
+    // The marker begins at the byte before the error's position, which is
+    // usually the whitespace before the token found, and runs to the end of
+    // the context
+    const size_t ctx_len = ctx_end - ctx_start;
+    size_t marker_start = err.offset - ctx_start;
+    if (marker_start > 0)
+        marker_start--;
+    es.write(lex.start + ctx_start, ctx_len);
+    es << std::endl;
+    es << std::string(marker_start, ' ')
+       << std::string(ctx_len - marker_start, '^');
+    ctx.result.error.assign(es.str());
 }
 
 } // namespace sqltoast
@@ -8,20 +8,44 @@
 #define SQLTOAST_ERROR_H
 
 #include <initializer_list>
-#include <sstream>
 
 #include "context.h"
 
 namespace sqltoast {
 
-// Populates the parse context's error member with a crafted syntax error that
-// shows where the syntax error occurred
-void create_syntax_error_marker(parse_context_t& ctx, std::stringstream& es);
+// The functions below record a syntax error at the lexer's current token in
+// the parse context's result. Only the error's code, position and expected
+// symbols are stored; the message describing it is not built until parsing
+// has failed with it (see render_syntax_error()), so a production that fails
+// and is then abandoned for another alternative costs next to nothing.
 
-// Helper function to generate a syntax error about expecting to find a
-// particular symbol
+// Records that the parser expected to find a particular symbol
 void expect_error(parse_context_t& ctx, symbol_t expected);
 void expect_any_error(parse_context_t& ctx, std::initializer_list<symbol_t> expected);
+// Records that the parser expected to find the described construct, such as
+// "Expected <numeric term> after finding numeric operator". The description
+// must outlive the parse result, as string literals do.
+void expect_construct_error(parse_context_t& ctx, const char* description);
+// Records that the parser expected to find the start of a statement
+void expect_statement_error(parse_context_t& ctx);
+// Records that the input is invalid for the described reason, which must
+// outlive the parse result
+void invalid_syntax_error(parse_context_t& ctx, const char* description);
+
+// Forgets any syntax error recorded so that the parser can try another
+// alternative
+void clear_syntax_error(parse_context_t& ctx);
+
+// The most bytes of the line a syntax error is on that are shown before and
+// after the error's position in the error's message
+const size_t SYNTAX_ERROR_CONTEXT_BEFORE = 200;
+const size_t SYNTAX_ERROR_CONTEXT_AFTER = 80;
+
+// Sets the line and column of the result's syntax error and populates the
+// result's error member with a message describing the error that shows
+// where on its line the error occurred
+void render_syntax_error(parse_context_t& ctx);
+
 } // namespace sqltoast
 
 #endif /* SQLTOAST_ERROR_H */
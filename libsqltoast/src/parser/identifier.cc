@@ -6,7 +6,10 @@
 
 #include "sqltoast/sqltoast.h"
 
+#include "parser/char_class.h"
 #include "parser/identifier.h"
+#include "parser/keyword.h"
+#include "parser/scan.h"
 
 namespace sqltoast {
 
@@ -24,49 +27,55 @@ namespace sqltoast {
 // PostgreSQL use special qualifiers like 'U&"' to indicate a delimited identifier
 // that uses Unicode-encoded characters in the identifier.
 //
+// Keywords and non-delimited identifiers are both words starting with a latin1
+// alpha character (or, for identifiers, a byte of a UTF-8 encoded character),
+// so we tokenize them together: the word portion (alphanumerics, underscores
+// and UTF-8 bytes) is hashed while we find its end. If it isn't a keyword, we
+// continue consuming the characters that may only appear in identifiers.
+//
 // Note that whitespace will have been skipped already so that the character
 // pointed to by the parse context is guaranteed to be not whitespace.
-tokenize_result_t token_identifier(
+//
+// When padded is true, the input is followed by zero bytes (see
+// padded_input_t), which are neither word nor identifier characters, so the
+// word's boundary is found without comparing the cursor to end
+template <bool padded>
+static tokenize_result_t word(
         parse_position_t cursor,
         const parse_position_t end) {
     parse_position_t start = cursor;
-    escape_mode current_escape = ESCAPE_NONE;
-
-    // Let's first look to see if we have the potential start of a delimited
-    // identifier of some sort...
-    switch (*cursor) {
-        case '"':
-            current_escape = ESCAPE_DOUBLE_QUOTE;
-            cursor++;
-            break;
-        case '`':
-            current_escape = ESCAPE_TILDE;
-            cursor++;
-            break;
-        case 'U':
-            // TODO(jaypipes): Check for PostgreSQL-style Unicode delimited
-            // identifiers that look like U&"\0441\043B\043E\043D"
-            break;
+    uint32_t h = KW_HASH_SEED;
+    while ((padded || cursor != end) && char_is_word(*cursor)) {
+        h = kw_hash_step(h, *cursor, kw_hash_multiplier);
+        cursor++;
     }
-    if (current_escape != ESCAPE_NONE)
-        // handle delimited identifiers...
-        return token_delimited_identifier(cursor, end, current_escape);
 
-    // The first character of a non-delimited identifier must be a latin1 alpha
-    if (! std::isalpha(*cursor++))
-        return tokenize_result_t(TOKEN_NOT_FOUND);
+    symbol_t sym = lookup_keyword(&*start, cursor - start, h);
+    if (sym != SYMBOL_NONE)
+        return tokenize_result_t(sym, start, cursor);
 
-    // If we're not a delimited identifier, then consume all non-space characters
-    // until the end of the parse subject or the next whitespace character
-    while (cursor != end && (std::isalnum(*cursor) || *cursor == '.' || *cursor == '_' || *cursor == '*'))
+    // Not a keyword, so consume all the remaining identifier characters
+    // until the end of the parse subject or the next delimiter character
+    while ((padded || cursor != end) && char_is_identifier(*cursor))
         cursor++;
+    return tokenize_result_t(SYMBOL_IDENTIFIER, start, cursor);
+}
 
-    // if we went more than a single character, that's an identifier...
-    if (start != cursor)
-        return tokenize_result_t(SYMBOL_IDENTIFIER, start, cursor);
-    return tokenize_result_t(TOKEN_NOT_FOUND);
+tokenize_result_t token_word(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return word<false>(cursor, end);
+}
+
+tokenize_result_t token_word_padded(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return word<true>(cursor, end);
 }
 
+// cursor is pointing at the opening delimiter. The closing delimiter may
+// appear inside the identifier if it is doubled ("a""b" or `a``b`). The
+// identifier's lexeme includes the delimiters.
 tokenize_result_t token_delimited_identifier(
         parse_position_t cursor,
         const parse_position_t end,
@@ -84,18 +93,24 @@ tokenize_result_t token_delimited_identifier(
         default:
             return tokenize_result_t(TOKEN_NOT_FOUND);
     }
-    char c;
-    while (cursor != end) {
-        cursor++;
-        c = *cursor;
-        if (c == closer) {
-            return tokenize_result_t(SYMBOL_IDENTIFIER, start, cursor);
+    const char* opener = &*cursor;
+    const char* stop = opener + (end - cursor);
+    const char* p = opener + 1;
+    for (;;) {
+        p = scan_find_byte(p, stop, closer);
+        if (p == stop)
+            break;
+        if ((stop - p) > 1 && *(p + 1) == closer) {
+            // Doubled delimiter
+            p += 2;
+            continue;
         }
+        return tokenize_result_t(SYMBOL_IDENTIFIER, start, cursor + (p + 1 - opener));
     }
     // We will get here if there was a start of a delimited escape sequence but we
     // never found the closing escape character(s). Set the parse context's
     // error to indicate the location that an error occurred.
-    return tokenize_result_t(TOKEN_ERR_NO_CLOSING_DELIMITER, start, cursor);
+    return tokenize_result_t(TOKEN_ERR_NO_CLOSING_DELIMITER, start, end);
 }
 
 } // namespace sqltoast
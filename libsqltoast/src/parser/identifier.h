@@ -11,14 +11,20 @@
 
 namespace sqltoast {
 
-// Returns true if an identifier (of any kind) can be parsed from the parse
-// context's cursor position
-tokenize_result_t token_identifier(
+// Tokenizes the word starting at the cursor, which must point at a latin1
+// alpha character. If the word is a keyword, the token's symbol is the
+// keyword's symbol, otherwise the word is a non-delimited identifier.
+tokenize_result_t token_word(
+        parse_position_t cursor,
+        const parse_position_t end);
+// As token_word(), but the input must be followed by zero padding (see
+// padded_input_t)
+tokenize_result_t token_word_padded(
         parse_position_t cursor,
         const parse_position_t end);
 
 // Returns true if a delimited identifier can be parsed from the parse
-// context's cursor position.
+// context's cursor position, which must point at the opening delimiter.
 tokenize_result_t token_delimited_identifier(
         parse_position_t cursor,
         const parse_position_t end,
@@ -6,362 +6,260 @@
 
 #include "sqltoast/sqltoast.h"
 
-#include "parser/compare.h"
 #include "parser/keyword.h"
 #include "parser/symbol.h"
 
 namespace sqltoast {
 
+typedef struct kw_entry {
+    symbol_t symbol;
+    const char *kw_str;
+} kw_entry_t;
+
 // NOTE(jaypipes): These keywords are inserted in order of FREQUENCY of
 // appearance in SQL statements, not alphabetically.
-kw_jump_table_t _init_kw_jump_table(char lead_char) {
-    kw_jump_table_t t;
+constexpr kw_entry_t kw_entries[] = {
+    {SYMBOL_AND, "AND"},
+    {SYMBOL_AS, "AS"},
+    {SYMBOL_AVG, "AVG"},
+    {SYMBOL_ALTER, "ALTER"},
+    {SYMBOL_ALL, "ALL"},
+    {SYMBOL_ANY, "ANY"},
+    {SYMBOL_ACTION, "ACTION"},
+    {SYMBOL_AT, "AT"},
+    {SYMBOL_ADD, "ADD"},
+    {SYMBOL_AUTHORIZATION, "AUTHORIZATION"},
+    {SYMBOL_BETWEEN, "BETWEEN"},
+    {SYMBOL_BY, "BY"},
+    {SYMBOL_BIT, "BIT"},
+    {SYMBOL_BIT_LENGTH, "BIT_LENGTH"},
+    {SYMBOL_BOTH, "BOTH"},
+    {SYMBOL_COUNT, "COUNT"},
+    {SYMBOL_COMMIT, "COMMIT"},
+    {SYMBOL_CREATE, "CREATE"},
+    {SYMBOL_CURRENT_DATE, "CURRENT_DATE"},
+    {SYMBOL_CURRENT_TIME, "CURRENT_TIME"},
+    {SYMBOL_CURRENT_TIMESTAMP, "CURRENT_TIMESTAMP"},
+    {SYMBOL_CURRENT_USER, "CURRENT_USER"},
+    {SYMBOL_COALESCE, "COALESCE"},
+    {SYMBOL_CASE, "CASE"},
+    {SYMBOL_CROSS, "CROSS"},
+    {SYMBOL_CONVERT, "CONVERT"},
+    {SYMBOL_CHAR_LENGTH, "CHAR_LENGTH"},
+    {SYMBOL_CHARACTER_LENGTH, "CHARACTER_LENGTH"},
+    {SYMBOL_CHAR, "CHAR"},
+    {SYMBOL_CHARACTER, "CHARACTER"},
+    {SYMBOL_CASCADE, "CASCADE"},
+    {SYMBOL_CHECK, "CHECK"},
+    {SYMBOL_COLUMN, "COLUMN"},
+    {SYMBOL_COLLATE, "COLLATE"},
+    {SYMBOL_COLLATION, "COLLATION"},
+    {SYMBOL_CONSTRAINT, "CONSTRAINT"},
+    {SYMBOL_CASCADED, "CASCADED"},
+    {SYMBOL_DELETE, "DELETE"},
+    {SYMBOL_DISTINCT, "DISTINCT"},
+    {SYMBOL_DATE, "DATE"},
+    {SYMBOL_DAY, "DAY"},
+    {SYMBOL_DEC, "DEC"},
+    {SYMBOL_DECIMAL, "DECIMAL"},
+    {SYMBOL_DEFAULT, "DEFAULT"},
+    {SYMBOL_DROP, "DROP"},
+    {SYMBOL_DOUBLE, "DOUBLE"},
+    {SYMBOL_DOMAIN, "DOMAIN"},
+    {SYMBOL_EXISTS, "EXISTS"},
+    {SYMBOL_END, "END"},
+    {SYMBOL_ELSE, "ELSE"},
+    {SYMBOL_EXTRACT, "EXTRACT"},
+    {SYMBOL_ESCAPE, "ESCAPE"},
+    {SYMBOL_FROM, "FROM"},
+    {SYMBOL_FOR, "FOR"},
+    {SYMBOL_FLOAT, "FLOAT"},
+    {SYMBOL_FULL, "FULL"},
+    {SYMBOL_FOREIGN, "FOREIGN"},
+    {SYMBOL_GROUP, "GROUP"},
+    {SYMBOL_GLOBAL, "GLOBAL"},
+    {SYMBOL_GRANT, "GRANT"},
+    {SYMBOL_HAVING, "HAVING"},
+    {SYMBOL_HOUR, "HOUR"},
+    {SYMBOL_IN, "IN"},
+    {SYMBOL_INSERT, "INSERT"},
+    {SYMBOL_INTO, "INTO"},
+    {SYMBOL_IS, "IS"},
+    {SYMBOL_INNER, "INNER"},
+    {SYMBOL_INTERVAL, "INTERVAL"},
+    {SYMBOL_INT, "INT"},
+    {SYMBOL_INTEGER, "INTEGER"},
+    {SYMBOL_JOIN, "JOIN"},
+    {SYMBOL_KEY, "KEY"},
+    {SYMBOL_LIKE, "LIKE"},
+    {SYMBOL_LEFT, "LEFT"},
+    {SYMBOL_LOWER, "LOWER"},
+    {SYMBOL_LOCAL, "LOCAL"},
+    {SYMBOL_LEADING, "LEADING"},
+    {SYMBOL_MAX, "MAX"},
+    {SYMBOL_MIN, "MIN"},
+    {SYMBOL_MATCH, "MATCH"},
+    {SYMBOL_MINUTE, "MINUTE"},
+    {SYMBOL_MONTH, "MONTH"},
+    {SYMBOL_NOT, "NOT"},
+    {SYMBOL_NO, "NO"},
+    {SYMBOL_NULL, "NULL"},
+    {SYMBOL_NULLIF, "NULLIF"},
+    {SYMBOL_NATURAL, "NATURAL"},
+    {SYMBOL_NATIONAL, "NATIONAL"},
+    {SYMBOL_NCHAR, "NCHAR"},
+    {SYMBOL_NUMERIC, "NUMERIC"},
+    {SYMBOL_OR, "OR"},
+    {SYMBOL_ON, "ON"},
+    {SYMBOL_OUTER, "OUTER"},
+    {SYMBOL_OCTET_LENGTH, "OCTET_LENGTH"},
+    {SYMBOL_OPTION, "OPTION"},
+    {SYMBOL_OVERLAPS, "OVERLAPS"},
+    {SYMBOL_POSITION, "POSITION"},
+    {SYMBOL_PRECISION, "PRECISION"},
+    {SYMBOL_PRIMARY, "PRIMARY"},
+    {SYMBOL_PARTIAL, "PARTIAL"},
+    {SYMBOL_PRIVILEGES, "PRIVILEGES"},
+    {SYMBOL_PUBLIC, "PUBLIC"},
+    {SYMBOL_ROLLBACK, "ROLLBACK"},
+    {SYMBOL_RIGHT, "RIGHT"},
+    {SYMBOL_REAL, "REAL"},
+    {SYMBOL_REFERENCES, "REFERENCES"},
+    {SYMBOL_RESTRICT, "RESTRICT"},
+    {SYMBOL_SELECT, "SELECT"},
+    {SYMBOL_SET, "SET"},
+    {SYMBOL_SUM, "SUM"},
+    {SYMBOL_SCHEMA, "SCHEMA"},
+    {SYMBOL_SECOND, "SECOND"},
+    {SYMBOL_SUBSTRING, "SUBSTRING"},
+    {SYMBOL_SMALLINT, "SMALLINT"},
+    {SYMBOL_SESSION_USER, "SESSION_USER"},
+    {SYMBOL_SYSTEM_USER, "SYSTEM_USER"},
+    {SYMBOL_SOME, "SOME"},
+    {SYMBOL_TABLE, "TABLE"},
+    {SYMBOL_TIME, "TIME"},
+    {SYMBOL_TIMESTAMP, "TIMESTAMP"},
+    {SYMBOL_TEMPORARY, "TEMPORARY"},
+    {SYMBOL_TRIM, "TRIM"},
+    {SYMBOL_THEN, "THEN"},
+    {SYMBOL_TO, "TO"},
+    {SYMBOL_TRAILING, "TRAILING"},
+    {SYMBOL_TRANSLATE, "TRANSLATE"},
+    {SYMBOL_TRANSLATION, "TRANSLATION"},
+    {SYMBOL_UPDATE, "UPDATE"},
+    {SYMBOL_UPPER, "UPPER"},
+    {SYMBOL_USING, "USING"},
+    {SYMBOL_UNION, "UNION"},
+    {SYMBOL_USER, "USER"},
+    {SYMBOL_UNIQUE, "UNIQUE"},
+    {SYMBOL_USAGE, "USAGE"},
+    {SYMBOL_VALUES, "VALUES"},
+    {SYMBOL_VARCHAR, "VARCHAR"},
+    {SYMBOL_VARYING, "VARYING"},
+    {SYMBOL_VIEW, "VIEW"},
+    {SYMBOL_VALUE, "VALUE"},
+    {SYMBOL_WHERE, "WHERE"},
+    {SYMBOL_WITH, "WITH"},
+    {SYMBOL_WHEN, "WHEN"},
+    {SYMBOL_WORK, "WORK"},
+    {SYMBOL_YEAR, "YEAR"},
+    {SYMBOL_ZONE, "ZONE"},
+};
+const size_t NUM_KEYWORDS = sizeof(kw_entries) / sizeof(kw_entry_t);
+
+static_assert(NUM_KEYWORDS < 256,
+        "keyword hash table slots store keyword indexes as uint8_t");
+
+constexpr size_t kw_len(const char *kw_str) {
+    size_t len = 0;
+    while (kw_str[len] != '\0')
+        len++;
+    return len;
+}
 
-    switch (lead_char) {
-        case 'a':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_AND, "AND"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_AS, "AS"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_AVG, "AVG"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ALTER, "ALTER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ALL, "ALL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ANY, "ANY"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ACTION, "ACTION"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_AT, "AT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ADD, "ADD"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_AUTHORIZATION, "AUTHORIZATION"));
-            return t;
-        case 'b':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_BETWEEN, "BETWEEN"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_BY, "BY"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_BIT, "BIT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_BIT_LENGTH, "BIT_LENGTH"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_BOTH, "BOTH"));
-            return t;
-        case 'c':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_COUNT, "COUNT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_COMMIT, "COMMIT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CREATE, "CREATE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CURRENT_DATE, "CURRENT_DATE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CURRENT_TIME, "CURRENT_TIME"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CURRENT_TIMESTAMP, "CURRENT_TIMESTAMP"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CURRENT_USER, "CURRENT_USER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_COALESCE, "COALESCE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CASE, "CASE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CROSS, "CROSS"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CONVERT, "CONVERT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CHAR_LENGTH, "CHAR_LENGTH"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CHARACTER_LENGTH, "CHARACTER_LENGTH"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CHAR, "CHAR"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CHARACTER, "CHARACTER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CASCADE, "CASCADE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CHECK, "CHECK"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_COLUMN, "COLUMN"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_COLLATE, "COLLATE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_COLLATION, "COLLATION"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CONSTRAINT, "CONSTRAINT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_CASCADED, "CASCADED"));
-            return t;
-        case 'd':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DELETE, "DELETE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DISTINCT, "DISTINCT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DATE, "DATE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DAY, "DAY"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DEC, "DEC"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DECIMAL, "DECIMAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DEFAULT, "DEFAULT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DROP, "DROP"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DOUBLE, "DOUBLE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_DOMAIN, "DOMAIN"));
-            return t;
-        case 'e':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_EXISTS, "EXISTS"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_END, "END"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ELSE, "ELSE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_EXTRACT, "EXTRACT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ESCAPE, "ESCAPE"));
-            return t;
-        case 'f':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_FROM, "FROM"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_FOR, "FOR"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_FLOAT, "FLOAT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_FULL, "FULL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_FOREIGN, "FOREIGN"));
-            return t;
-        case 'g':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_GROUP, "GROUP"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_GLOBAL, "GLOBAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_GRANT, "GRANT"));
-            return t;
-        case 'h':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_HAVING, "HAVING"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_HOUR, "HOUR"));
-            return t;
-        case 'i':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_IN, "IN"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_INSERT, "INSERT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_INTO, "INTO"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_IS, "IS"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_INNER, "INNER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_INTERVAL, "INTERVAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_INT, "INT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_INTEGER, "INTEGER"));
-            return t;
-        case 'j':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_JOIN, "JOIN"));
-            return t;
-        case 'k':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_KEY, "KEY"));
-            return t;
-        case 'l':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_LIKE, "LIKE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_LEFT, "LEFT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_LOWER, "LOWER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_LOCAL, "LOCAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_LEADING, "LEADING"));
-            return t;
-        case 'm':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_MAX, "MAX"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_MIN, "MIN"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_MATCH, "MATCH"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_MINUTE, "MINUTE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_MONTH, "MONTH"));
-            return t;
-        case 'n':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NOT, "NOT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NO, "NO"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NULL, "NULL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NULLIF, "NULLIF"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NATURAL, "NATURAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NATIONAL, "NATIONAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NCHAR, "NCHAR"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_NUMERIC, "NUMERIC"));
-            return t;
-        case 'o':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_OR, "OR"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ON, "ON"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_OUTER, "OUTER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_OCTET_LENGTH, "OCTET_LENGTH"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_OPTION, "OPTION"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_OVERLAPS, "OVERLAPS"));
-            return t;
-        case 'p':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_POSITION, "POSITION"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_PRECISION, "PRECISION"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_PRIMARY, "PRIMARY"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_PARTIAL, "PARTIAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_PRIVILEGES, "PRIVILEGES"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_PUBLIC, "PUBLIC"));
-            return t;
-        case 'r':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ROLLBACK, "ROLLBACK"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_RIGHT, "RIGHT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_REAL, "REAL"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_REFERENCES, "REFERENCES"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_RESTRICT, "RESTRICT"));
-            return t;
-        case 's':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SELECT, "SELECT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SET, "SET"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SUM, "SUM"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SCHEMA, "SCHEMA"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SECOND, "SECOND"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SUBSTRING, "SUBSTRING"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SMALLINT, "SMALLINT"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SESSION_USER, "SESSION_USER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SYSTEM_USER, "SYSTEM_USER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_SOME, "SOME"));
-            return t;
-        case 't':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TABLE, "TABLE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TIME, "TIME"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TIMESTAMP, "TIMESTAMP"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TEMPORARY, "TEMPORARY"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TRIM, "TRIM"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_THEN, "THEN"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TO, "TO"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TRAILING, "TRAILING"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TRANSLATE, "TRANSLATE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_TRANSLATION, "TRANSLATION"));
-            return t;
-        case 'u':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_UPDATE, "UPDATE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_UPPER, "UPPER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_USING, "USING"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_UNION, "UNION"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_USER, "USER"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_UNIQUE, "UNIQUE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_USAGE, "USAGE"));
-            return t;
-        case 'v':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_VALUES, "VALUES"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_VARCHAR, "VARCHAR"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_VARYING, "VARYING"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_VIEW, "VIEW"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_VALUE, "VALUE"));
-            return t;
-        case 'w':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_WHERE, "WHERE"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_WITH, "WITH"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_WHEN, "WHEN"));
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_WORK, "WORK"));
-            return t;
-        case 'y':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_YEAR, "YEAR"));
-            return t;
-        case 'z':
-            t.emplace_back(kw_jump_table_entry_t(SYMBOL_ZONE, "ZONE"));
-            return t;
+constexpr uint32_t kw_hash(const char *kw_str, const uint32_t multiplier) {
+    uint32_t h = KW_HASH_SEED;
+    for (size_t x = 0; kw_str[x] != '\0'; x++)
+        h = kw_hash_step(h, kw_str[x], multiplier);
+    return h;
+}
+
+constexpr bool kw_hash_is_perfect(const uint32_t multiplier) {
+    bool used[KW_HASH_SIZE] = {};
+    for (size_t x = 0; x < NUM_KEYWORDS; x++) {
+        size_t slot = kw_hash_slot(kw_hash(kw_entries[x].kw_str, multiplier));
+        if (used[slot])
+            return false;
+        used[slot] = true;
     }
-    return t;
+    return true;
 }
 
-kw_jump_table_t kw_jump_tables::a = _init_kw_jump_table('a');
-kw_jump_table_t kw_jump_tables::b = _init_kw_jump_table('b');
-kw_jump_table_t kw_jump_tables::c = _init_kw_jump_table('c');
-kw_jump_table_t kw_jump_tables::d = _init_kw_jump_table('d');
-kw_jump_table_t kw_jump_tables::e = _init_kw_jump_table('e');
-kw_jump_table_t kw_jump_tables::f = _init_kw_jump_table('f');
-kw_jump_table_t kw_jump_tables::g = _init_kw_jump_table('g');
-kw_jump_table_t kw_jump_tables::h = _init_kw_jump_table('h');
-kw_jump_table_t kw_jump_tables::i = _init_kw_jump_table('i');
-kw_jump_table_t kw_jump_tables::j = _init_kw_jump_table('j');
-kw_jump_table_t kw_jump_tables::k = _init_kw_jump_table('k');
-kw_jump_table_t kw_jump_tables::l = _init_kw_jump_table('l');
-kw_jump_table_t kw_jump_tables::m = _init_kw_jump_table('m');
-kw_jump_table_t kw_jump_tables::n = _init_kw_jump_table('n');
-kw_jump_table_t kw_jump_tables::o = _init_kw_jump_table('o');
-kw_jump_table_t kw_jump_tables::p = _init_kw_jump_table('p');
-kw_jump_table_t kw_jump_tables::r = _init_kw_jump_table('r');
-kw_jump_table_t kw_jump_tables::s = _init_kw_jump_table('s');
-kw_jump_table_t kw_jump_tables::t = _init_kw_jump_table('t');
-kw_jump_table_t kw_jump_tables::u = _init_kw_jump_table('u');
-kw_jump_table_t kw_jump_tables::v = _init_kw_jump_table('v');
-kw_jump_table_t kw_jump_tables::w = _init_kw_jump_table('w');
-kw_jump_table_t kw_jump_tables::y = _init_kw_jump_table('y');
-kw_jump_table_t kw_jump_tables::z = _init_kw_jump_table('z');
+// Walks a fixed sequence of odd multipliers until one is found that hashes
+// every keyword into its own slot. The search starts at a multiplier known to
+// be perfect for the keyword list above, so normally this costs a single
+// check. Adding a keyword that collides makes the compiler keep walking the
+// sequence; there is no table to regenerate by hand.
+const uint32_t KW_HASH_MULTIPLIER_START = 0x10DCC889;
+const uint32_t KW_HASH_MULTIPLIER_STEP = 0x6A09E668;
+const size_t KW_HASH_MAX_TRIES = 4096;
 
-tokenize_result_t token_keyword(
-        parse_position_t cursor,
-        const parse_position_t end) {
-    kw_jump_table_t* jump_tbl;
-    switch (*cursor) {
-        case 'a':
-        case 'A':
-            jump_tbl = &kw_jump_tables::a;
-            break;
-        case 'b':
-        case 'B':
-            jump_tbl = &kw_jump_tables::b;
-            break;
-        case 'c':
-        case 'C':
-            jump_tbl = &kw_jump_tables::c;
-            break;
-        case 'd':
-        case 'D':
-            jump_tbl = &kw_jump_tables::d;
-            break;
-        case 'e':
-        case 'E':
-            jump_tbl = &kw_jump_tables::e;
-            break;
-        case 'f':
-        case 'F':
-            jump_tbl = &kw_jump_tables::f;
-            break;
-        case 'g':
-        case 'G':
-            jump_tbl = &kw_jump_tables::g;
-            break;
-        case 'h':
-        case 'H':
-            jump_tbl = &kw_jump_tables::h;
-            break;
-        case 'i':
-        case 'I':
-            jump_tbl = &kw_jump_tables::i;
-            break;
-        case 'j':
-        case 'J':
-            jump_tbl = &kw_jump_tables::j;
-            break;
-        case 'k':
-        case 'K':
-            jump_tbl = &kw_jump_tables::k;
-            break;
-        case 'l':
-        case 'L':
-            jump_tbl = &kw_jump_tables::l;
-            break;
-        case 'm':
-        case 'M':
-            jump_tbl = &kw_jump_tables::m;
-            break;
-        case 'n':
-        case 'N':
-            jump_tbl = &kw_jump_tables::n;
-            break;
-        case 'o':
-        case 'O':
-            jump_tbl = &kw_jump_tables::o;
-            break;
-        case 'p':
-        case 'P':
-            jump_tbl = &kw_jump_tables::p;
-            break;
-        case 'r':
-        case 'R':
-            jump_tbl = &kw_jump_tables::r;
-            break;
-        case 's':
-        case 'S':
-            jump_tbl = &kw_jump_tables::s;
-            break;
-        case 't':
-        case 'T':
-            jump_tbl = &kw_jump_tables::t;
-            break;
-        case 'u':
-        case 'U':
-            jump_tbl = &kw_jump_tables::u;
-            break;
-        case 'v':
-        case 'V':
-            jump_tbl = &kw_jump_tables::v;
-            break;
-        case 'w':
-        case 'W':
-            jump_tbl = &kw_jump_tables::w;
-            break;
-        case 'y':
-        case 'Y':
-            jump_tbl = &kw_jump_tables::y;
-            break;
-        case 'z':
-        case 'Z':
-            jump_tbl = &kw_jump_tables::z;
-            break;
-        default:
-            return tokenize_result_t(TOKEN_NOT_FOUND);
+constexpr uint32_t kw_find_hash_multiplier() {
+    uint32_t multiplier = KW_HASH_MULTIPLIER_START;
+    for (size_t x = 0; x < KW_HASH_MAX_TRIES; x++) {
+        if (kw_hash_is_perfect(multiplier))
+            return multiplier;
+        multiplier += KW_HASH_MULTIPLIER_STEP;
     }
+    return 0;
+}
+
+constexpr uint32_t KW_HASH_MULTIPLIER = kw_find_hash_multiplier();
+static_assert(KW_HASH_MULTIPLIER != 0,
+        "failed to find a perfect hash multiplier for the keyword list");
+
+const uint32_t kw_hash_multiplier = KW_HASH_MULTIPLIER;
+
+// Each slot holds the index + 1 of the keyword in kw_entries that hashes to
+// the slot, or 0 if no keyword hashes to the slot
+typedef struct kw_hash_table {
+    uint8_t slots[KW_HASH_SIZE];
+    uint8_t lens[NUM_KEYWORDS];
+} kw_hash_table_t;
+
+constexpr kw_hash_table_t kw_build_hash_table() {
+    kw_hash_table_t t = {};
+    for (size_t x = 0; x < NUM_KEYWORDS; x++) {
+        const char *kw_str = kw_entries[x].kw_str;
+        t.slots[kw_hash_slot(kw_hash(kw_str, KW_HASH_MULTIPLIER))] = x + 1;
+        t.lens[x] = kw_len(kw_str);
+    }
+    return t;
+}
 
-    parse_position_t start = cursor;
-    // Find the next delimiter character...
-    while (cursor != end && (std::isalnum(*cursor) || *cursor == '_'))
-        cursor++;
+constexpr kw_hash_table_t kw_table = kw_build_hash_table();
 
-    const std::string lexeme(start, cursor);
-    const size_t lexeme_len = cursor - start;
-    size_t entry_len;
-    for (auto entry : *jump_tbl) {
-        entry_len = entry.kw_str.size();
-        if (lexeme_len != entry_len)
-            continue;
-        if (ci_find_substr(lexeme, entry.kw_str) == 0) {
-            return tokenize_result_t(entry.symbol, start, cursor);
-        }
+symbol_t lookup_keyword(const char* word, size_t len, uint32_t h) {
+    if (len > KW_MAX_LEN)
+        return SYMBOL_NONE;
+    const uint8_t slot = kw_table.slots[kw_hash_slot(h)];
+    if (slot == 0)
+        return SYMBOL_NONE;
+    const size_t idx = slot - 1;
+    if (kw_table.lens[idx] != len)
+        return SYMBOL_NONE;
+    // Keyword strings are upper-case, so folding the candidate's lower-case
+    // latin1 alpha characters is all that is needed for a case-insensitive
+    // compare
+    const char *kw_str = kw_entries[idx].kw_str;
+    for (size_t x = 0; x < len; x++) {
+        char c = word[x];
+        if (c >= 'a' && c <= 'z')
+            c -= ('a' - 'A');
+        if (c != kw_str[x])
+            return SYMBOL_NONE;
     }
-    return tokenize_result_t(TOKEN_NOT_FOUND);
+    return kw_entries[idx].symbol;
 }
 
 } // namespace sqltoast
@@ -7,56 +7,51 @@
 #ifndef SQLTOAST_PARSER_KEYWORD_H
 #define SQLTOAST_PARSER_KEYWORD_H
 
-#include "parser/lexer.h"
+#include <cstddef>
+#include <cstdint>
+
 #include "parser/symbol.h"
 
 namespace sqltoast {
 
-typedef struct kw_jump_table_entry {
-    symbol_t symbol;
-    const std::string kw_str;
-    kw_jump_table_entry(symbol_t sym, const char *kw_str) :
-        symbol(sym), kw_str(kw_str)
-    {}
-} kw_jump_table_entry_t;
-typedef std::vector<kw_jump_table_entry_t> kw_jump_table_t;
-
-struct kw_jump_tables {
-    // There is a separate list of jump table entries for each lead character
-    static kw_jump_table_t a;
-    static kw_jump_table_t b;
-    static kw_jump_table_t c;
-    static kw_jump_table_t d;
-    static kw_jump_table_t e;
-    static kw_jump_table_t f;
-    static kw_jump_table_t g;
-    static kw_jump_table_t h;
-    static kw_jump_table_t i;
-    static kw_jump_table_t j;
-    static kw_jump_table_t k;
-    static kw_jump_table_t l;
-    static kw_jump_table_t m;
-    static kw_jump_table_t n;
-    static kw_jump_table_t o;
-    static kw_jump_table_t p;
-    static kw_jump_table_t r;
-    static kw_jump_table_t s;
-    static kw_jump_table_t t;
-    static kw_jump_table_t u;
-    static kw_jump_table_t v;
-    static kw_jump_table_t w;
-    static kw_jump_table_t y;
-    static kw_jump_table_t z;
-};
-
-kw_jump_table_t _init_kw_jump_table(const char c);
-
-// Moves the supplied parse context's cursor to the next keyword found in the
-// context's input stream and sets the context's current symbol to the found
-// keyword symbol. Returns whether a keyword was found.
-tokenize_result_t token_keyword(
-        parse_position_t cursor,
-        const parse_position_t end);
+// Keywords are looked up with a perfect hash over the case-folded bytes of the
+// candidate word. The hash is computed incrementally while the word's
+// boundary is being found, so a lookup costs a single probe into the hash
+// table, a length check and one case-insensitive compare.
+const size_t KW_HASH_BITS = 11;
+const size_t KW_HASH_SIZE = (1 << KW_HASH_BITS);
+const uint32_t KW_HASH_SEED = 0x811C9DC5;
+
+// The longest keyword we have is CURRENT_TIMESTAMP. Any word longer than this
+// cannot be a keyword.
+const size_t KW_MAX_LEN = 17;
+
+// ASCII case folding that works on raw bytes. Keywords are only made up of
+// latin1 alpha characters and the underscore. Folding digits and the
+// underscore this way is harmless since keyword strings are folded the same.
+constexpr inline uint32_t kw_fold(const char c) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(c) | 0x20);
+}
+
+constexpr inline uint32_t kw_hash_step(
+        const uint32_t h,
+        const char c,
+        const uint32_t multiplier) {
+    return (h ^ kw_fold(c)) * multiplier;
+}
+
+constexpr inline size_t kw_hash_slot(const uint32_t h) {
+    return h >> (32 - KW_HASH_BITS);
+}
+
+// The multiplier used by the keyword hash. It is chosen at compile time (see
+// keyword.cc) so that no two keywords share a hash slot.
+extern const uint32_t kw_hash_multiplier;
+
+// Returns the keyword symbol for the supplied word of the supplied length,
+// given the word's hash, or SYMBOL_NONE if the word is not a keyword.
+// Case-insensitive.
+symbol_t lookup_keyword(const char* word, size_t len, uint32_t h);
 
 } // namespace sqltoast
 
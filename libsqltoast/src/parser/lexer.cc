@@ -4,120 +4,403 @@
  * See the COPYING file in the root project directory for full text.
  */
 
+#include <algorithm>
+
 #include "sqltoast/sqltoast.h"
 
 #include "context.h"
 #include "error.h"
+#include "parser/char_class.h"
 #include "parser/comment.h"
 #include "parser/identifier.h"
 #include "parser/lexer.h"
 #include "parser/literal.h"
 #include "parser/keyword.h"
+#include "parser/scan.h"
 #include "parser/special.h"
 #include "parser/token.h"
 
 namespace sqltoast {
 
-parse_position_t skip_simple_comments(parse_position_t cursor) {
-    parse_position_t start = cursor;
-    if (*cursor != '-')
-        return start;
+static_assert(PADDED_INPUT_PADDING >= SCAN_PADDING,
+        "padded input must have room for the padded scanners' loads");
 
-    cursor++;
-    if (*cursor != '-') {
-        return start;
-    }
+parse_position_t skip_simple_comments(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    if ((end - cursor) < 2 || *cursor != '-' || *(cursor + 1) != '-')
+        return cursor;
 
     // The comment content is from the cursor until we find a newline or EOS
-    do {
-        cursor++;
-    } while (*cursor != '\0' && *cursor != '\n');
-    return cursor;
+    const char* comment = &*cursor;
+    const char* comment_end = comment + (end - cursor);
+    return cursor + (scan_find_byte(comment + 2, comment_end, '\n') - comment);
 }
 
-parse_position_t skip(parse_position_t cur) {
+parse_position_t skip(parse_position_t cur, const parse_position_t end) {
     // Advance the lexer's cursor over any whitespace or simple comments
-    while (std::isspace(*cur))
-        cur++;
-    cur = skip_simple_comments(cur);
+    while (cur != end) {
+        if (char_is_space(*cur)) {
+            // Most tokens are separated by a single space, so we only hand
+            // off to the vectorized scanner when there's a run of whitespace
+            if (++cur != end && char_is_space(*cur)) {
+                const char* ws = &*cur;
+                cur += scan_skip_space(ws, ws + (end - cur)) - ws;
+            }
+            continue;
+        }
+        parse_position_t after_comment = skip_simple_comments(cur, end);
+        if (after_comment == cur)
+            break;
+        cur = after_comment;
+    }
     return cur;
 }
 
-static size_t NUM_TOKENIZERS = 5;
-static tokenize_func_t tokenizers[5] = {
-    &token_comment,
-    &token_special,
-    &token_keyword,
-    &token_literal,
-    &token_identifier
-};
+parse_position_t skip_padded(parse_position_t cur, const parse_position_t end) {
+    // The zero padding after end is neither whitespace nor the start of a
+    // simple comment, so we always stop at or before end without checking
+    for (;;) {
+        if (char_is_space(*cur)) {
+            if (char_is_space(*++cur)) {
+                const char* ws = &*cur;
+                cur += scan_skip_space_padded(ws, ws + (end - cur)) - ws;
+            }
+            continue;
+        }
+        if (*cur != '-' || *(cur + 1) != '-')
+            return cur;
+        const char* comment = &*cur;
+        const char* comment_end = comment + (end - cur);
+        cur += scan_find_byte_padded(comment + 2, comment_end, '\n') - comment;
+    }
+}
 
-parse_position_t lexer_t::peek_from(parse_position_t cur, symbol_t* found) const {
-    // Advance the lexer's cursor over any whitespace or simple comments
-    *found = SYMBOL_EOS;
-    cur = skip(cur);
-    if (cur >= end)
-        return cur;
+// Each byte that may start a token belongs to exactly one of these classes,
+// and each class is handled by exactly one tokenizer
+typedef enum lead_class {
+    LEAD_NONE, // no token may start with this byte
+    LEAD_SPECIAL,
+    LEAD_SOLIDUS, // start of a bracketed comment or a solidus
+    LEAD_WORD,
+    LEAD_PREFIXED_STRING, // N'', B'' or X'' literal, or else a word
+    LEAD_DIGIT,
+    LEAD_QUOTE,
+    LEAD_DOUBLE_QUOTE,
+    LEAD_BACKTICK
+} lead_class_t;
 
-    for (size_t x = 0; x < NUM_TOKENIZERS; x++) {
-        auto tok_res = tokenizers[x](cur, end);
-        if (tok_res.code == TOKEN_NOT_FOUND)
-            continue;
-        if (tok_res.code == TOKEN_FOUND) {
-            *found = tok_res.token.symbol;
-            cur = tok_res.token.lexeme.end;
+typedef struct lead_class_table {
+    uint8_t classes[256];
+} lead_class_table_t;
+
+constexpr lead_class_table_t build_lead_class_table() {
+    lead_class_table_t t = {};
+    for (int c = 'a'; c <= 'z'; c++) {
+        t.classes[c] = LEAD_WORD;
+        t.classes[c - 'a' + 'A'] = LEAD_WORD;
+    }
+    // Bytes of UTF-8 encoded characters may start a non-delimited identifier.
+    // See parser/char_class.h.
+    for (int c = 0x80; c <= 0xFF; c++)
+        t.classes[c] = LEAD_WORD;
+    for (int c = '0'; c <= '9'; c++)
+        t.classes[c] = LEAD_DIGIT;
+    // TODO(jaypipes): Check for PostgreSQL-style Unicode delimited
+    // identifiers that look like U&"\0441\043B\043E\043D"
+    t.classes[static_cast<uint8_t>('N')] = LEAD_PREFIXED_STRING;
+    t.classes[static_cast<uint8_t>('B')] = LEAD_PREFIXED_STRING;
+    t.classes[static_cast<uint8_t>('X')] = LEAD_PREFIXED_STRING;
+    t.classes[static_cast<uint8_t>('\'')] = LEAD_QUOTE;
+    t.classes[static_cast<uint8_t>('"')] = LEAD_DOUBLE_QUOTE;
+    t.classes[static_cast<uint8_t>('`')] = LEAD_BACKTICK;
+    t.classes[static_cast<uint8_t>('/')] = LEAD_SOLIDUS;
+    // A sign is always tokenized as a punctuator. The parser handles the sign
+    // of numeric values in <signed numeric literal> and <factor> productions.
+    const char specials[] = "\0,=()*<>!+-|;?:";
+    for (size_t x = 0; x < sizeof(specials) - 1; x++)
+        t.classes[static_cast<uint8_t>(specials[x])] = LEAD_SPECIAL;
+    return t;
+}
+
+constexpr lead_class_table_t lead_classes = build_lead_class_table();
+
+// When padded is true, the byte after the cursor is always readable and
+// tokenizers that would otherwise check every byte against end use the
+// padding to find the end of the token instead
+template <bool padded>
+static inline tokenize_result_t lex_at(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    switch (lead_classes.classes[static_cast<uint8_t>(*cursor)]) {
+        case LEAD_WORD:
+            if (padded)
+                return token_word_padded(cursor, end);
+            return token_word(cursor, end);
+        case LEAD_SPECIAL:
+            return token_special(cursor, end);
+        case LEAD_DIGIT:
+            if (padded)
+                return token_numeric_literal_padded(cursor, end, false);
+            return token_numeric_literal(cursor, end, false);
+        case LEAD_QUOTE:
+            return token_character_string_literal(cursor, end,
+                    SYMBOL_LITERAL_CHARACTER_STRING);
+        case LEAD_DOUBLE_QUOTE:
+            return token_delimited_identifier(cursor, end, ESCAPE_DOUBLE_QUOTE);
+        case LEAD_BACKTICK:
+            return token_delimited_identifier(cursor, end, ESCAPE_TILDE);
+        case LEAD_PREFIXED_STRING:
+            if ((padded || (cursor + 1) != end) && *(cursor + 1) == '\'') {
+                tokenize_result_t res = token_literal(cursor, end);
+                if (res.code != TOKEN_NOT_FOUND)
+                    return res;
+                // A malformed prefixed string literal is lexed as the word
+                // that is its prefix, followed by a character string literal
+            }
+            if (padded)
+                return token_word_padded(cursor, end);
+            return token_word(cursor, end);
+        case LEAD_SOLIDUS:
+            if ((padded || (cursor + 1) != end) && *(cursor + 1) == '*')
+                return token_comment(cursor, end);
+            return token_special(cursor, end);
+        default:
+            return tokenize_result_t(TOKEN_NOT_FOUND);
+    }
+}
+
+tokenize_result_t tokenize_at(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return lex_at<false>(cursor, end);
+}
+
+tokenize_result_t tokenize_at_padded(
+        parse_position_t cursor,
+        const parse_position_t end) {
+    return lex_at<true>(cursor, end);
+}
+
+// Returns the token described by the supplied compact token
+static inline token_t expand_token(
+        const parse_position_t start,
+        const compact_token_t& ct) {
+    token_t tok(ct.symbol, start + ct.start, start + ct.end);
+    switch (ct.symbol) {
+        case SYMBOL_LITERAL_APPROXIMATE_NUMBER:
+        case SYMBOL_LITERAL_SIGNED_DECIMAL:
+        case SYMBOL_LITERAL_SIGNED_INTEGER:
+        case SYMBOL_LITERAL_UNSIGNED_DECIMAL:
+        case SYMBOL_LITERAL_UNSIGNED_INTEGER:
+            // Compact tokens don't have room for a literal's value, so we
+            // decode it again. Numeric literals are short, and this is cheaper
+            // than making every compact token twice as big.
+            decode_numeric_literal(ct.symbol, tok.lexeme.start,
+                    tok.lexeme.end, &tok.value);
+            break;
+        default:
+            break;
+    }
+    return tok;
+}
+
+void lexer_t::tokenize() {
+    const size_t input_len = end - start;
+    if (input_len > UINT32_MAX)
+        return;
+
+    // The array grows geometrically as tokens are found. Reserving for the
+    // most tokens the input could hold would take several times the size of
+    // the input. A parser_t keeps the array's capacity from one input to the
+    // next.
+    tokens.clear();
+    tokens.push_back(compact_token_t{0, 0, SYMBOL_SOS});
+    parse_position_t cur = start;
+    for (;;) {
+        cur = padded ? skip_padded(cur, end) : skip(cur, end);
+        if (cur >= end) {
+            const uint32_t eos = static_cast<uint32_t>(input_len);
+            tokens.push_back(compact_token_t{eos, eos, SYMBOL_EOS});
+            break;
+        }
+        auto tok_res = padded ?
+            tokenize_at_padded(cur, end) : tokenize_at(cur, end);
+        if (tok_res.code == TOKEN_NOT_FOUND) {
+            // The lexer gets stuck here. Record where, so that next() behaves
+            // just as it does when tokenizing on demand.
+            const uint32_t stuck = static_cast<uint32_t>(cur - start);
+            tokens.push_back(compact_token_t{stuck, stuck, SYMBOL_NONE});
             break;
         }
-        // There was an error in tokenizing... return some error marker?
-        break;
+        // A token's lexeme does not necessarily begin at the cursor. The
+        // lexeme of a national or bit string literal, for instance, excludes
+        // the N, B or X prefix.
+        const token_t& tok = tok_res.token;
+        tokens.push_back(compact_token_t{
+            static_cast<uint32_t>(tok.lexeme.start - start),
+            static_cast<uint32_t>(tok.lexeme.end - start),
+            tok.symbol
+        });
+        cur = tok.lexeme.end;
     }
-    return cur;
+    index = 0;
+}
+
+const lookahead_t& lexer_t::scan(parse_position_t from) const {
+    for (size_t x = 0; x < lookahead_len; x++) {
+        if (lookahead[x].from == from)
+            return lookahead[x];
+    }
+
+    lookahead_t& la = lookahead[lookahead_next];
+    lookahead_next = (lookahead_next + 1) % LEXER_LOOKAHEAD_SIZE;
+    if (lookahead_len < LEXER_LOOKAHEAD_SIZE)
+        lookahead_len++;
+
+    // Advance over any whitespace or simple comments
+    la.from = from;
+    if (padded) {
+        la.at = skip_padded(from, end);
+        if (la.at >= end)
+            la.result = tokenize_result_t(TOKEN_NOT_FOUND);
+        else
+            la.result = tokenize_at_padded(la.at, end);
+        return la;
+    }
+    la.at = skip(from, end);
+    if (la.at >= end)
+        la.result = tokenize_result_t(TOKEN_NOT_FOUND);
+    else
+        la.result = tokenize_at(la.at, end);
+    return la;
+}
+
+parse_position_t lexer_t::peek_from(parse_position_t cur, symbol_t* found) const {
+    *found = SYMBOL_EOS;
+    if (! tokens.empty()) {
+        // Find the first token at or after the supplied cursor, which is
+        // almost always the token after the current one
+        const uint32_t offset = static_cast<uint32_t>(cur - start);
+        const size_t last = tokens.size() - 1;
+        size_t x = index + 1;
+        if (x > last || tokens[index].start >= offset) {
+            auto it = std::lower_bound(tokens.cbegin(), tokens.cbegin() + last,
+                    offset,
+                    [](const compact_token_t& ct, uint32_t off) {
+                        return ct.start < off;
+                    });
+            x = it - tokens.cbegin();
+        } else {
+            while (x < last && tokens[x].start < offset)
+                x++;
+        }
+        const compact_token_t& ct = tokens[x];
+        if (ct.symbol == SYMBOL_EOS || ct.symbol == SYMBOL_NONE ||
+                ct.symbol == SYMBOL_ERROR)
+            return start + ct.start;
+        *found = ct.symbol;
+        return start + ct.end;
+    }
+
+    const lookahead_t& la = scan(cur);
+    if (la.at >= end)
+        return la.at;
+    if (la.result.code == TOKEN_FOUND) {
+        *found = la.result.token.symbol;
+        return la.result.token.lexeme.end;
+    }
+    // There was an error in tokenizing... return some error marker?
+    return la.at;
 }
 
 symbol_t lexer_t::peek() const {
-    parse_position_t cur = cursor;
-    cur = skip(cur);
-    if (cur >= end)
-        return SYMBOL_EOS;
+    if (! tokens.empty()) {
+        if (tokens[index].symbol == SYMBOL_EOS)
+            return SYMBOL_EOS;
+        symbol_t sym = tokens[index + 1].symbol;
+        if (sym == SYMBOL_NONE || sym == SYMBOL_ERROR)
+            return SYMBOL_EOS;
+        return sym;
+    }
 
-    for (size_t x = 0; x < NUM_TOKENIZERS; x++) {
-        auto tok_res = tokenizers[x](cur, end);
-        if (tok_res.code == TOKEN_NOT_FOUND)
-            continue;
-        if (tok_res.code == TOKEN_FOUND)
-            return tok_res.token.symbol;
-        // There was an error in tokenizing... return some error marker?
+    const lookahead_t& la = scan(cursor);
+    if (la.at >= end)
         return SYMBOL_EOS;
-    }
-    // No more tokens
+    if (la.result.code == TOKEN_FOUND)
+        return la.result.token.symbol;
+    // There was an error in tokenizing or no more tokens
     return SYMBOL_EOS;
 }
 
 token_t& lexer_t::next() {
-    parse_position_t cur = cursor;
-    cur = skip(cur);
-    if (cur >= end) {
+    if (! tokens.empty()) {
+        if (tokens[index].symbol == SYMBOL_EOS)
+            return current_token;
+        const compact_token_t& ct = tokens[index + 1];
+        if (ct.symbol == SYMBOL_NONE) {
+            cursor = start + ct.start;
+            return current_token;
+        }
+        index++;
+        current_token = expand_token(start, ct);
+        cursor = current_token.lexeme.end;
+        return current_token;
+    }
+
+    const lookahead_t& la = scan(cursor);
+    if (la.at >= end) {
         current_token.symbol = SYMBOL_EOS;
         current_token.lexeme.start = end;
         current_token.lexeme.end = end;
-        cursor = cur;
+        cursor = la.at;
         return current_token;
     }
 
-    for (size_t x = 0; x < NUM_TOKENIZERS; x++) {
-        auto tok_res = tokenizers[x](cur, end);
-        tokenize_result_code_t res_code = tok_res.code;
-        if (res_code == TOKEN_NOT_FOUND)
-            continue;
-        // If there was an error in finding the next token, then tok_res.token
+    if (la.result.code != TOKEN_NOT_FOUND) {
+        // If there was an error in finding the next token, then the token
         // will contain SYMBOL_ERROR and the lexeme will point to the place
         // where the lexing error occurring.
-        current_token = tok_res.token;
-        cur = tok_res.token.lexeme.end;
-        break;
+        current_token = la.result.token;
+        cursor = la.result.token.lexeme.end;
+        return current_token;
     }
-    cursor = cur;
+    cursor = la.at;
     return current_token;
 }
 
+void lexer_t::rewind(const lexer_checkpoint_t& cp) {
+    if (! tokens.empty()) {
+        index = cp.index;
+        current_token = expand_token(start, tokens[index]);
+        cursor = current_token.lexeme.end;
+        return;
+    }
+    cursor = cp.scan.cursor;
+    current_token = cp.scan.token;
+}
+
+void lexer_t::rewind_cursor(const lexer_checkpoint_t& cp) {
+    if (! tokens.empty()) {
+        index = cp.index;
+        cursor = start + tokens[index].end;
+        return;
+    }
+    cursor = cp.scan.cursor;
+}
+
+void lexer_t::seek(parse_position_t pos) {
+    cursor = pos;
+    if (tokens.empty())
+        return;
+    // The current token becomes the last one before the position, skipping
+    // the SYMBOL_SOS token and never going past the final token
+    const uint32_t offset = static_cast<uint32_t>(pos - start);
+    auto it = std::lower_bound(tokens.cbegin() + 1, tokens.cend() - 1, offset,
+            [](const compact_token_t& ct, uint32_t off) {
+                return ct.start < off;
+            });
+    index = (it - tokens.cbegin()) - 1;
+}
+
 } // namespace sqltoast
@@ -7,6 +7,9 @@
 #ifndef SQLTOAST_PARSER_LEXER_H
 #define SQLTOAST_PARSER_LEXER_H
 
+#include <cstdint>
+#include <vector>
+
 #include "parser/token.h"
 
 namespace sqltoast {
@@ -20,30 +23,6 @@ enum escape_mode {
     ESCAPE_UNICODE_AMPERSAND = 4
 };
 
-typedef struct lexer {
-    parse_position_t start;
-    parse_position_t end;
-    parse_position_t cursor;
-    token_t current_token;
-    lexer(parse_input_t& subject) :
-        start(subject.cbegin()),
-        end(subject.cend()),
-        cursor(subject.cbegin()),
-        current_token(SYMBOL_SOS, subject.cbegin(), subject.cbegin())
-    {}
-    // Returns the next symbol after the lexer's current cursor.
-    symbol_t peek() const;
-    // Populates a supplied symbol pointer with the value of the symbol found
-    // after the supplied cursor. If not symbol was found, the symbol pointer
-    // will contain SYMBOL_EOS. Returns the cursor's position after having
-    // found the next symbol.
-    parse_position_t peek_from(parse_position_t cur, symbol_t* sym) const;
-
-    // Attempts to find the next token. If a token was found, returns a pointer
-    // to that token, else NULL.
-    token_t& next();
-} lexer_t;
-
 typedef enum tokenize_result_code {
     TOKEN_NOT_FOUND,
     TOKEN_FOUND,
@@ -72,16 +51,157 @@ typedef struct tokenize_result {
     {}
 } tokenize_result_t;
 
-typedef tokenize_result_t (*tokenize_func_t) (
+// The size of the lexer's lookahead ring buffer. This is enough for the
+// longest sequence of keywords the parser peeks at, such as CREATE GLOBAL
+// TEMPORARY TABLE.
+const size_t LEXER_LOOKAHEAD_SIZE = 4;
+
+// The result of scanning for a token from some position in the input. The
+// lexer keeps the most recent of these so that tokens found by peek() and
+// peek_from() are not tokenized again by a later call to next().
+typedef struct lookahead {
+    // The position scanning started from
+    parse_position_t from;
+    // The position after skipping whitespace and comments from the scan start
+    parse_position_t at;
+    // The token found at the position after skipping, if any
+    tokenize_result_t result;
+    lookahead() :
+        from(), at(), result(TOKEN_NOT_FOUND)
+    {}
+} lookahead_t;
+
+// A compact representation of a token found when the lexer tokenizes its
+// entire input up front. The lexeme is stored as a pair of byte offsets from
+// the start of the input, which keeps the token array small and contiguous.
+typedef struct compact_token {
+    uint32_t start;
+    uint32_t end;
+    symbol_t symbol;
+} compact_token_t;
+
+// The state a lexer that tokenizes on demand saves in a checkpoint
+typedef struct lexer_scan_state {
+    parse_position_t cursor;
+    token_t token;
+} lexer_scan_state_t;
+
+// A saved lexer state that the parser can later rewind to. When the lexer has
+// tokenized its input up front, the index into the token array is all that
+// is saved. Otherwise the cursor and current token are.
+typedef struct lexer_checkpoint {
+    union {
+        size_t index;
+        lexer_scan_state_t scan;
+    };
+    explicit lexer_checkpoint(size_t index) :
+        index(index)
+    {}
+    lexer_checkpoint(parse_position_t cursor, const token_t& token) :
+        scan{cursor, token}
+    {}
+} lexer_checkpoint_t;
+
+typedef struct lexer {
+    parse_position_t start;
+    parse_position_t end;
+    parse_position_t cursor;
+    token_t current_token;
+    // When not empty, the lexer operates on this array of tokens instead of
+    // tokenizing the input as the parser asks for each token. The first
+    // element is always the SYMBOL_SOS token and the last element is either
+    // the SYMBOL_EOS token or, if the lexer could not find a token at some
+    // position, a SYMBOL_NONE marker at that position.
+    std::vector<compact_token_t> tokens;
+    // Index into the tokens array of the current token
+    size_t index;
+    // Ring buffer of recent scan results, used when not operating on an
+    // array of tokens. Because the input never changes, an entry remains
+    // valid for as long as the lexer lives, including across rewinds.
+    mutable lookahead_t lookahead[LEXER_LOOKAHEAD_SIZE];
+    mutable size_t lookahead_len;
+    mutable size_t lookahead_next;
+    // True when the input is followed by zero padding (see padded_input_t),
+    // in which case the lexer uses skip_padded() and tokenize_at_padded()
+    bool padded;
+    lexer(parse_position_t start, parse_position_t end, bool padded) :
+        start(start),
+        end(end),
+        cursor(start),
+        current_token(SYMBOL_SOS, start, start),
+        tokens(),
+        index(0),
+        lookahead(),
+        lookahead_len(0),
+        lookahead_next(0),
+        padded(padded)
+    {}
+    // Tokenizes the entire input into the tokens array. After this is called,
+    // next(), peek() and rewind() are simple operations on the array and no
+    // byte of the input is ever lexed more than once, no matter how much the
+    // parser backtracks. Must be called before the first call to next(). Does
+    // nothing if the input is too large to be addressed by a compact token.
+    void tokenize();
+    // Returns the next symbol after the lexer's current cursor.
+    symbol_t peek() const;
+    // Populates a supplied symbol pointer with the value of the symbol found
+    // after the supplied cursor. If not symbol was found, the symbol pointer
+    // will contain SYMBOL_EOS. Returns the cursor's position after having
+    // found the next symbol.
+    parse_position_t peek_from(parse_position_t cur, symbol_t* sym) const;
+
+    // Attempts to find the next token. If a token was found, returns a pointer
+    // to that token, else NULL.
+    token_t& next();
+
+    // Returns the lexer's current state so that the parser can return to it
+    // after an unsuccessful attempt at parsing some production
+    inline lexer_checkpoint_t checkpoint() const {
+        if (! tokens.empty())
+            return lexer_checkpoint_t(index);
+        return lexer_checkpoint_t(cursor, current_token);
+    }
+    // Restores the lexer's cursor and current token to a saved checkpoint
+    void rewind(const lexer_checkpoint_t& cp);
+    // Restores the lexer's cursor to a saved checkpoint but leaves the current
+    // token alone. The next call to next() returns the token following the
+    // checkpoint.
+    void rewind_cursor(const lexer_checkpoint_t& cp);
+    // Moves the lexer to the supplied position, which must not be inside a
+    // token, so that the next call to next() returns the first token at or
+    // after it. Used by the parser to skip over input it has parsed some
+    // other way.
+    void seek(parse_position_t pos);
+
+    // Returns the result of scanning for a token from the supplied position,
+    // from the lookahead ring buffer if possible
+    const lookahead_t& scan(parse_position_t from) const;
+} lexer_t;
+
+// Returns the token starting at the supplied cursor, which must not point at
+// whitespace or a simple comment. The cursor's byte determines which single
+// tokenizer is called.
+tokenize_result_t tokenize_at(
+        parse_position_t cursor,
+        const parse_position_t end);
+// As tokenize_at(), but the input must be followed by zero padding (see
+// padded_input_t)
+tokenize_result_t tokenize_at_padded(
         parse_position_t cursor,
         const parse_position_t end);
 
 // Advances the supplied cursor past any whitespace and simple SQL comments and
 // returns the location of the cursor after skipping
-parse_position_t skip(parse_position_t cur);
-// Advances the supplied cursor past any simple SQL comments and returns the
-// location of the cursor after skipping
-parse_position_t skip_simple_comments(parse_position_t cursor);
+parse_position_t skip(parse_position_t cur, const parse_position_t end);
+// As skip(), but the input must be followed by zero padding (see
+// padded_input_t)
+parse_position_t skip_padded(parse_position_t cur, const parse_position_t end);
+// Advances the supplied cursor past a simple SQL comment, if one starts at the
+// cursor, and returns the location of the newline terminating the comment (or
+// end if the comment was not terminated)
+parse_position_t skip_simple_comments(
+        parse_position_t cursor,
+        const parse_position_t end);
 
 } // namespace sqltoast
 
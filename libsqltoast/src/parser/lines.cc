@@ -0,0 +1,53 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <algorithm>
+
+#include "parser/lines.h"
+#include "parser/scan.h"
+
+namespace sqltoast {
+
+void line_index::build(const char* start, const char* end) {
+    this->start = start;
+    this->end = end;
+    newlines.clear();
+    scan_index_byte(start, end, '\n', start, newlines);
+}
+
+size_t line_index::line(size_t offset) const {
+    // A newline belongs to the line it ends
+    auto it = std::lower_bound(newlines.cbegin(), newlines.cend(), offset);
+    return (it - newlines.cbegin()) + 1;
+}
+
+size_t line_index::line_start(size_t line) const {
+    if (line < 2)
+        return 0;
+    return newlines[line - 2] + 1;
+}
+
+size_t line_index::line_end(size_t line) const {
+    if (line > newlines.size())
+        return end - start;
+    return newlines[line - 1];
+}
+
+void line_origin::advance(const char* start, const char* end) {
+    const char* last_newline = nullptr;
+    const char* p = scan_find_byte(start, end, '\n');
+    while (p != end) {
+        line++;
+        last_newline = p;
+        p = scan_find_byte(p + 1, end, '\n');
+    }
+    if (last_newline == nullptr)
+        column += end - start;
+    else
+        column = end - last_newline;
+}
+
+} // namespace sqltoast
@@ -0,0 +1,61 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_LINES_H
+#define SQLTOAST_PARSER_LINES_H
+
+#include <cstddef>
+#include <vector>
+
+namespace sqltoast {
+
+// An index of the newlines in some input, so that the line and column of any
+// offset into the input can be found with a binary search. The index is built
+// with one vectorized pass over the input, and only when it is first needed,
+// which is usually never: the parser only asks for it to report where a
+// syntax error is.
+typedef struct line_index {
+    // Byte offsets from the start of the input of each newline, in input
+    // order
+    std::vector<size_t> newlines;
+    // The input the index was built from
+    const char* start;
+    const char* end;
+    line_index() :
+        start(nullptr),
+        end(nullptr)
+    {}
+    inline bool empty() const {
+        return start == nullptr;
+    }
+    // Indexes the newlines in [start, end)
+    void build(const char* start, const char* end);
+    // Returns the line, counting from 1, that the byte at the supplied offset
+    // is on
+    size_t line(size_t offset) const;
+    // Return the offsets of the first byte of the supplied line and of the
+    // newline (or end of input) that ends it
+    size_t line_start(size_t line) const;
+    size_t line_end(size_t line) const;
+} line_index_t;
+
+// Where some input begins within a larger input it was cut from, such as a
+// stream, as the line and column (in bytes) of its first byte, both counting
+// from 1
+typedef struct line_origin {
+    size_t line;
+    size_t column;
+    line_origin() :
+        line(1),
+        column(1)
+    {}
+    // Moves the origin past the bytes in [start, end)
+    void advance(const char* start, const char* end);
+} line_origin_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_LINES_H */
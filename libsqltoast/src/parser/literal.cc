@@ -4,22 +4,29 @@
  * See the COPYING file in the root project directory for full text.
  */
 
+#include <cstdlib>
+#include <cstring>
+#include <locale.h>
+#include <string>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
 #include "sqltoast/sqltoast.h"
 
+#include "parser/char_class.h"
 #include "parser/literal.h"
+#include "parser/scan.h"
 
 namespace sqltoast {
 
-// cursor is pointing at a non-space, non-\0 char
+// cursor is pointing at a non-space, non-\0 char. A sign is never part of the
+// literal: it is always tokenized as a punctuator, and the lexer only calls
+// us for an N, B or X followed by a quote.
 tokenize_result_t token_literal(
         parse_position_t cursor,
         const parse_position_t end) {
     switch (*cursor) {
-        case '+':
-        case '-':
-            if (! std::isdigit(*(cursor + 1)))
-                return tokenize_result_t(TOKEN_NOT_FOUND);
-            return token_numeric_literal(cursor, end, true);
         case '0':
         case '1':
         case '2':
@@ -56,8 +63,11 @@ tokenize_result_t token_literal(
 }
 
 // cursor is pointing at a digit if found_sign is false, or either the + or -
-// char if found_sign is true
-tokenize_result_t token_numeric_literal(
+// char if found_sign is true. When padded is true, the input is followed by
+// zero bytes (see padded_input_t) and the end of the input is found by
+// hitting the first of them instead of comparing the cursor to end.
+template <bool padded>
+static tokenize_result_t numeric_literal(
         parse_position_t cursor,
         const parse_position_t end,
         bool found_sign) {
@@ -73,18 +83,18 @@ tokenize_result_t token_numeric_literal(
     found_sym = SYMBOL_LITERAL_UNSIGNED_INTEGER;
     if (found_sign)
         found_sym = SYMBOL_LITERAL_SIGNED_INTEGER;
-    while (cursor != end) {
-        if (std::isspace(*cursor)) {
+    while (padded || cursor != end) {
+        if (char_is_space(*cursor)) {
             if (found_e) {
                 // Make sure the exponent has at least one number
-                if (! std::isdigit(*(cursor - 1)))
+                if (! char_is_digit(*(cursor - 1)))
                     goto not_found;
                 found_sym = SYMBOL_LITERAL_APPROXIMATE_NUMBER;
             }
             goto push_literal;
         }
         c = *cursor;
-        if (std::isdigit(c)) {
+        if (char_is_digit(c)) {
             cursor++;
             continue;
         }
@@ -99,7 +109,7 @@ tokenize_result_t token_numeric_literal(
                     goto not_found;
                 if (found_e) {
                     // Make sure the exponent has at least one number
-                    if (! std::isdigit(*(cursor - 1)))
+                    if (! char_is_digit(*(cursor - 1)))
                         goto not_found;
                     found_sym = SYMBOL_LITERAL_APPROXIMATE_NUMBER;
                 }
@@ -124,7 +134,7 @@ tokenize_result_t token_numeric_literal(
                 // <exact numeric literal>E<signed integer> grammar
                 found_e = true;
                 // Make sure we have found at least a digit before the 'E'
-                if (! std::isdigit(*(cursor - 2)))
+                if (! char_is_digit(*(cursor - 2)))
                     goto not_found;
                 cursor++;
                 continue;
@@ -136,10 +146,15 @@ tokenize_result_t token_numeric_literal(
                     goto not_found;
                 cursor++;
                 continue;
+            case '\0':
+                if (padded && cursor == end)
+                    goto end_of_input;
+                goto not_found;
             default:
                 goto not_found;
         }
     }
+end_of_input:
     // We get here if we hit the EOS but had parsed at least a number.  Make
     // sure if we got a single . that we followed it with at least one
     // number...
@@ -149,39 +164,250 @@ tokenize_result_t token_numeric_literal(
             goto not_found;
         // Make sure the exponent has at least one number
         if (found_e) {
-            if (! std::isdigit(last_char))
+            if (! char_is_digit(last_char))
                 goto not_found;
             found_sym = SYMBOL_LITERAL_APPROXIMATE_NUMBER;
         }
         goto push_literal;
     }
 push_literal:
-    return tokenize_result_t(found_sym, start, cursor);
+    {
+        tokenize_result_t res(found_sym, start, cursor);
+        decode_numeric_literal(found_sym, start, cursor, &res.token.value);
+        return res;
+    }
 not_found:
     return tokenize_result_t(TOKEN_NOT_FOUND);
 }
 
-// cursor is pointing at the \' char
+tokenize_result_t token_numeric_literal(
+        parse_position_t cursor,
+        const parse_position_t end,
+        bool found_sign) {
+    return numeric_literal<false>(cursor, end, found_sign);
+}
+
+tokenize_result_t token_numeric_literal_padded(
+        parse_position_t cursor,
+        const parse_position_t end,
+        bool found_sign) {
+    return numeric_literal<true>(cursor, end, found_sign);
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SQLTOAST_SWAR_DIGITS 1
+#endif
+
+#if defined(SQLTOAST_SWAR_DIGITS)
+
+// Returns true if all eight bytes packed into the supplied word are ASCII
+// digits
+static inline bool is_eight_digits(const uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+            (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+        0x3333333333333333;
+}
+
+// Returns the value of the eight ASCII digits packed into the supplied word,
+// with the first digit in the lowest byte. The digits are combined pairwise
+// with three multiplications instead of eight multiply-adds.
+static inline uint64_t parse_eight_digits(uint64_t chunk) {
+    chunk -= 0x3030303030303030;
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+            (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+}
+
+#endif // defined(SQLTOAST_SWAR_DIGITS)
+
+// Accumulates the run of ASCII digits starting at p into *value, for as long
+// as doing so cannot overflow 19 decimal digits. Digits after that are counted
+// in *dropped. The number of digits accumulated is added to *accumulated.
+// Returns a pointer to the first byte after the run.
+static const char* accumulate_digits(
+        const char* p,
+        const char* end,
+        uint64_t* value,
+        size_t* accumulated,
+        size_t* dropped) {
+#if defined(SQLTOAST_SWAR_DIGITS)
+    while ((end - p) >= 8 && *value < 100000000000ULL) {
+        uint64_t chunk;
+        std::memcpy(&chunk, p, sizeof(chunk));
+        if (! is_eight_digits(chunk))
+            break;
+        *value = (*value * 100000000) + parse_eight_digits(chunk);
+        *accumulated += 8;
+        p += 8;
+    }
+#endif
+    while (p != end && *p >= '0' && *p <= '9') {
+        if (*value < 1000000000000000000ULL) {
+            *value = (*value * 10) + (*p - '0');
+            (*accumulated)++;
+        } else {
+            (*dropped)++;
+        }
+        p++;
+    }
+    return p;
+}
+
+// Powers of ten that are exactly representable as a double
+static const double exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+void decode_numeric_literal(
+        symbol_t literal_sym,
+        parse_position_t start,
+        const parse_position_t end,
+        literal_value_t* out) {
+    const char* p = &*start;
+    const char* stop = p + (end - start);
+    bool negative = false;
+    uint64_t mantissa = 0;
+    size_t accumulated = 0;
+    size_t dropped = 0;
+    size_t frac_digits = 0;
+    int64_t exponent = 0;
+
+    if (*p == '+' || *p == '-') {
+        negative = (*p == '-');
+        p++;
+    }
+    p = accumulate_digits(p, stop, &mantissa, &accumulated, &dropped);
+
+    switch (literal_sym) {
+        case SYMBOL_LITERAL_UNSIGNED_INTEGER:
+        case SYMBOL_LITERAL_SIGNED_INTEGER:
+            // At most one digit can have been dropped from an integer that
+            // fits in 64 bits
+            if (dropped > 1)
+                goto overflow;
+            if (dropped == 1) {
+                const uint64_t last = *(stop - 1) - '0';
+                if (mantissa > (UINT64_MAX - last) / 10)
+                    goto overflow;
+                mantissa = (mantissa * 10) + last;
+            }
+            if (literal_sym == SYMBOL_LITERAL_UNSIGNED_INTEGER) {
+                out->type = LITERAL_VALUE_UNSIGNED_INTEGER;
+                out->uint_value = mantissa;
+                return;
+            }
+            {
+                const uint64_t max_magnitude =
+                    static_cast<uint64_t>(INT64_MAX) + (negative ? 1 : 0);
+                if (mantissa > max_magnitude)
+                    goto overflow;
+            }
+            out->type = LITERAL_VALUE_SIGNED_INTEGER;
+            out->int_value = static_cast<int64_t>(negative ? 0 - mantissa : mantissa);
+            return;
+        default:
+            break;
+    }
+
+    // Decimal and approximate numbers. Digits dropped before the decimal
+    // point scale the mantissa, while those dropped after it do not. Any
+    // dropped digit means the mantissa is inexact.
+    exponent = dropped;
+    if (p != stop && *p == '.') {
+        p = accumulate_digits(p + 1, stop, &mantissa, &frac_digits, &dropped);
+        exponent -= frac_digits;
+    }
+    if (p != stop && (*p == 'E' || *p == 'e')) {
+        bool exp_negative = false;
+        int64_t exp_value = 0;
+        p++;
+        if (p != stop && (*p == '+' || *p == '-')) {
+            exp_negative = (*p == '-');
+            p++;
+        }
+        for (; p != stop; p++) {
+            // Clamp absurdly large exponents, which round to zero or infinity
+            // anyway
+            if (exp_value < 100000)
+                exp_value = (exp_value * 10) + (*p - '0');
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+
+    out->type = LITERAL_VALUE_DOUBLE;
+    if (dropped == 0 && mantissa <= (1ULL << 53) &&
+            exponent >= -22 && exponent <= 22) {
+        // Both the mantissa and the power of ten are exact doubles, so a
+        // single multiplication or division is correctly rounded
+        double val = static_cast<double>(mantissa);
+        if (exponent < 0)
+            val /= exact_powers_of_ten[-exponent];
+        else
+            val *= exact_powers_of_ten[exponent];
+        out->double_value = negative ? -val : val;
+        return;
+    }
+    // Anything else needs the correctly rounded conversion of strtod(). We
+    // use strtod_l() with the C locale, since strtod() honours the current
+    // locale's decimal point. The token is not NUL-terminated, so it is
+    // copied first.
+    {
+        static const locale_t c_locale = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+        const size_t len = end - start;
+        char buf[64];
+        std::string long_buf;
+        char* lit = buf;
+        if (len >= sizeof(buf)) {
+            long_buf.assign(&*start, len);
+            lit = &long_buf[0];
+        } else {
+            std::memcpy(buf, &*start, len);
+            buf[len] = '\0';
+        }
+        out->double_value = strtod_l(lit, NULL, c_locale);
+    }
+    return;
+overflow:
+    out->type = LITERAL_VALUE_OVERFLOW;
+    out->uint_value = 0;
+}
+
+// cursor is pointing at the \' char. A quote inside the literal is escaped
+// either by doubling it ('') or by preceding it with a backslash (\').
 tokenize_result_t token_character_string_literal(
         parse_position_t cursor,
         const parse_position_t end,
         symbol_t literal_sym) {
     parse_position_t start = cursor;
-    char c = *cursor++;
-    char last_c = c;
-    while (cursor != end) {
-        c = *cursor++;
-        if (c == '\'' && last_c != '\\') {
-            last_c = c;
-            break;
+    const char* opener = &*cursor;
+    const char* stop = opener + (end - cursor);
+    const char* p = opener + 1;
+    for (;;) {
+        // Jump straight to the next quote or backslash, since nothing else
+        // inside the literal can end it
+        p = scan_find_byte2(p, stop, '\'', '\\');
+        if (p == stop)
+            goto no_closing_quote;
+        if (*p == '\\') {
+            // Skip over the backslash and the character it escapes
+            if ((stop - p) < 2)
+                goto no_closing_quote;
+            p += 2;
+            continue;
         }
-        last_c = c;
+        if ((stop - p) > 1 && *(p + 1) == '\'') {
+            // Doubled quote
+            p += 2;
+            continue;
+        }
+        return tokenize_result_t(literal_sym, start, cursor + (p + 1 - opener));
     }
-    if (last_c == '\'' && (cursor - start > 1))
-        goto push_literal;
-    return tokenize_result_t(TOKEN_NOT_FOUND);
-push_literal:
-    return tokenize_result_t(literal_sym, start, cursor);
+no_closing_quote:
+    // The literal runs to the end of the input without its closing quote.
+    // The error spans the rest of the input, just as it does for an
+    // unterminated delimited identifier or comment.
+    return tokenize_result_t(TOKEN_ERR_NO_CLOSING_DELIMITER, start, end);
 }
 
 // cursor is pointing at the \' char
@@ -193,7 +419,7 @@ tokenize_result_t token_bit_string_literal(
     char last_c = c;
     while (cursor != end) {
         c = *cursor;
-        if (std::isspace(c))
+        if (char_is_space(c))
             break;
         if (c != '0' && c != '1' && c != '\'')
             return tokenize_result_t(TOKEN_NOT_FOUND);
@@ -216,9 +442,9 @@ tokenize_result_t token_hex_string_literal(
     char last_c = c;
     while (cursor != end) {
         c = *cursor;
-        if (std::isspace(c))
+        if (char_is_space(c))
             break;
-        if (! std::isxdigit(c) && c != '\'')
+        if (! char_is_xdigit(c) && c != '\'')
             return tokenize_result_t(TOKEN_NOT_FOUND);
         last_c = c;
         ++cursor;
@@ -11,9 +11,9 @@
 
 namespace sqltoast {
 
-// Moves the supplied parse context's cursor to the next literal found in the
-// context's input stream and adds a token with type literal to the tokens
-// stack.Returns whether a literal was found.
+// Returns the unsigned numeric, character string, national character string,
+// bit string or hex string literal beginning at the cursor, or
+// TOKEN_NOT_FOUND if there is none.
 tokenize_result_t token_literal(
         parse_position_t cursor,
         const parse_position_t end);
@@ -22,6 +22,21 @@ tokenize_result_t token_numeric_literal(
         parse_position_t cursor,
         const parse_position_t end,
         bool found_sign);
+// As token_numeric_literal(), but the input must be followed by zero padding
+// (see padded_input_t)
+tokenize_result_t token_numeric_literal_padded(
+        parse_position_t cursor,
+        const parse_position_t end,
+        bool found_sign);
+
+// Decodes the value of the numeric literal spanning [start, end), which must
+// have been found by token_numeric_literal() to be a literal of the supplied
+// symbol, into the supplied numeric value
+void decode_numeric_literal(
+        symbol_t literal_sym,
+        parse_position_t start,
+        const parse_position_t end,
+        literal_value_t* out);
 
 tokenize_result_t token_character_string_literal(
         parse_position_t cursor,
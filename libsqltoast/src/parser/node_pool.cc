@@ -0,0 +1,118 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <new>
+
+#include "sqltoast/sqltoast.h"
+
+namespace sqltoast {
+
+// Node sizes are rounded up to a multiple of this, and each multiple up to
+// NODE_POOL_MAX_SIZE has its own free list. Larger nodes are rare and are
+// always allocated from the system.
+const size_t NODE_POOL_GRANULARITY = 16;
+const size_t NODE_POOL_MAX_SIZE = 512;
+const size_t NODE_POOL_NUM_CLASSES = NODE_POOL_MAX_SIZE / NODE_POOL_GRANULARITY;
+// The most blocks a single free list will hold on to. Beyond this, freed
+// memory goes back to the system allocator.
+const size_t NODE_POOL_MAX_CACHED = 4096;
+
+typedef struct free_block {
+    free_block* next;
+} free_block_t;
+
+typedef struct node_pool {
+    free_block_t* free_lists[NODE_POOL_NUM_CLASSES];
+    size_t num_cached[NODE_POOL_NUM_CLASSES];
+    node_pool() :
+        free_lists(),
+        num_cached()
+    {}
+    ~node_pool();
+    void trim() {
+        for (size_t x = 0; x < NODE_POOL_NUM_CLASSES; x++) {
+            free_block_t* block = free_lists[x];
+            while (block != nullptr) {
+                free_block_t* next = block->next;
+                ::operator delete(block);
+                block = next;
+            }
+            free_lists[x] = nullptr;
+            num_cached[x] = 0;
+        }
+    }
+} node_pool_t;
+
+typedef enum node_pool_state {
+    NODE_POOL_UNUSED,
+    NODE_POOL_ALIVE,
+    NODE_POOL_DESTROYED
+} node_pool_state_t;
+
+// The state is trivially destructible, so it stays readable after the thread's
+// pool has been destroyed at thread exit. Nodes freed after that, by the
+// destructor of some other thread-local or static object, go straight back to
+// the system allocator.
+static thread_local node_pool_state_t pool_state = NODE_POOL_UNUSED;
+static thread_local node_pool_t pool;
+
+node_pool::~node_pool() {
+    trim();
+    pool_state = NODE_POOL_DESTROYED;
+}
+
+static inline node_pool_t* get_pool() {
+    if (pool_state == NODE_POOL_DESTROYED)
+        return nullptr;
+    node_pool_t* p = &pool;
+    pool_state = NODE_POOL_ALIVE;
+    return p;
+}
+
+static inline size_t size_class(size_t size) {
+    return (size - 1) / NODE_POOL_GRANULARITY;
+}
+
+void* node_pool_alloc(size_t size) {
+    if (size == 0 || size > NODE_POOL_MAX_SIZE)
+        return ::operator new(size);
+    const size_t cls = size_class(size);
+    node_pool_t* p = get_pool();
+    if (p != nullptr && p->free_lists[cls] != nullptr) {
+        free_block_t* block = p->free_lists[cls];
+        p->free_lists[cls] = block->next;
+        p->num_cached[cls]--;
+        return block;
+    }
+    return ::operator new((cls + 1) * NODE_POOL_GRANULARITY);
+}
+
+void node_pool_free(void* ptr, size_t size) {
+    if (ptr == nullptr)
+        return;
+    if (size == 0 || size > NODE_POOL_MAX_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+    const size_t cls = size_class(size);
+    node_pool_t* p = get_pool();
+    if (p == nullptr || p->num_cached[cls] >= NODE_POOL_MAX_CACHED) {
+        ::operator delete(ptr);
+        return;
+    }
+    free_block_t* block = static_cast<free_block_t*>(ptr);
+    block->next = p->free_lists[cls];
+    p->free_lists[cls] = block;
+    p->num_cached[cls]++;
+}
+
+void node_pool_trim() {
+    node_pool_t* p = get_pool();
+    if (p != nullptr)
+        p->trim();
+}
+
+} // namespace sqltoast
@@ -4,41 +4,47 @@
  * See the COPYING file in the root project directory for full text.
  */
 
-#include <cctype>
 #include <sstream>
 
 #include "parser/context.h"
 #include "parser/error.h"
 #include "parser/lexer.h"
 #include "parser/parse.h"
+#include "parser/scan.h"
 #include "parser/token.h"
 
 namespace sqltoast {
 
-parse_result_t parse(parse_input_t& subject) {
-    parse_options_t opts = {
+static inline parse_options_t default_options() {
+    return parse_options_t{
         SQL_DIALECT_ANSI_1992,
-        false
+        false,
+        false,
+        false,
+        0
     };
-
-    return parse(subject, opts);
 }
 
-parse_result_t parse(parse_input_t& subject, parse_options_t& opts) {
-    parse_result_t res;
-    res.code = PARSE_OK;
-    parse_context_t ctx(res, opts, subject);
+static void parse_statements(parse_context_t& ctx) {
+    parse_result_t& res = ctx.result;
+    parse_options_t& opts = ctx.opts;
     lexer_t& lex = ctx.lexer;
     token_t& cur_tok = lex.current_token;
 
     if (lex.cursor == lex.end) {
         res.code = PARSE_INPUT_ERROR;
         res.error.assign("Nothing to parse.");
-        return res;
+        return;
     }
+    if (opts.tokenize_once)
+        lex.tokenize();
+    // The structural index also tells the parser where the rows of a VALUES
+    // list are, so that it can parse them on several threads
+    if (opts.structural_index || opts.num_threads > 1)
+        ctx.structure.build(lex.start, lex.end);
     cur_tok = lex.next();
 
-    while (res.code == PARSE_OK) {
+    while (res.code == PARSE_OK && ! ctx.stopped) {
         if (cur_tok.symbol == SYMBOL_EOS)
             break;
         if (cur_tok.symbol == SYMBOL_SEMICOLON) {
@@ -49,16 +55,240 @@ parse_result_t parse(parse_input_t& subject, parse_options_t& opts) {
             parse_statement(ctx);
             continue;
         }
-        {
-            std::stringstream estr;
-            estr << "SQL statements begin with a keyword and end with a "
-                    "semicolon, but found " << cur_tok << "." << std::endl;
-            create_syntax_error_marker(ctx, estr);
-            continue;
-        }
+        expect_statement_error(ctx);
     }
+    // Only now that parsing has failed is the message describing the error
+    // built
+    if (res.code == PARSE_SYNTAX_ERROR)
+        render_syntax_error(ctx);
+}
+
+// The parts of a parser_t that are private to the parser
+typedef struct parser_state {
+    std::vector<compact_token_t> tokens;
+    structural_index_t structure;
+} parser_state_t;
+
+static void parse_range_parallel(
+        parse_result_t& res,
+        parse_position_t start,
+        parse_position_t end,
+        bool padded,
+        parse_options_t& opts,
+        statement_handler_t* handler,
+        const line_origin_t& origin,
+        parser_state_t* state);
+
+// Parses into the supplied result. When state is not NULL, the lexer and the
+// context borrow its token array and structural index, so that they keep
+// their capacity from one parse to the next.
+static void parse_range_serial(
+        parse_result_t& res,
+        parse_position_t start,
+        parse_position_t end,
+        bool padded,
+        parse_options_t& opts,
+        statement_handler_t* handler,
+        const line_origin_t& origin,
+        parser_state_t* state) {
+    parse_context_t ctx(res, opts, start, end, padded, handler);
+    ctx.origin = origin;
+    if (state == nullptr) {
+        parse_statements(ctx);
+        return;
+    }
+    ctx.lexer.tokens.swap(state->tokens);
+    std::swap(ctx.structure, state->structure);
+    parse_statements(ctx);
+    ctx.lexer.tokens.swap(state->tokens);
+    std::swap(ctx.structure, state->structure);
+}
+
+static void parse_range_into(
+        parse_result_t& res,
+        parse_position_t start,
+        parse_position_t end,
+        bool padded,
+        parse_options_t& opts,
+        statement_handler_t* handler,
+        const line_origin_t& origin,
+        parser_state_t* state) {
+    if (opts.num_threads > 1)
+        parse_range_parallel(res, start, end, padded, opts, handler, origin,
+                state);
+    else
+        parse_range_serial(res, start, end, padded, opts, handler, origin,
+                state);
+}
 
+static parse_result_t parse_range(
+        parse_position_t start,
+        parse_position_t end,
+        bool padded,
+        parse_options_t& opts,
+        statement_handler_t* handler,
+        const line_origin_t& origin = line_origin_t()) {
+    parse_result_t res;
+    res.code = PARSE_OK;
+    parse_range_into(res, start, end, padded, opts, handler, origin, nullptr);
     return res;
 }
 
+// Splits the input into statements and parses them with parse_batch(). If a
+// statement fails to parse, we go back to parsing serially from the start of
+// that statement. The serial parser's error messages show where in the whole
+// input the error is, and it is the only way to be sure of reporting exactly
+// the error (and the statements before it) that a serial parse would.
+static void parse_range_parallel(
+        parse_result_t& res,
+        parse_position_t start,
+        parse_position_t end,
+        bool padded,
+        parse_options_t& opts,
+        statement_handler_t* handler,
+        const line_origin_t& origin,
+        parser_state_t* state) {
+    // A lone statement may still be an INSERT with a VALUES list long
+    // enough to be worth parsing on several threads
+    std::vector<statement_range_t> ranges = split_statements(start, end - start);
+    if (ranges.size() < 2) {
+        parse_range_serial(res, start, end, padded, opts, handler, origin,
+                state);
+        return;
+    }
+
+    parse_options_t serial_opts = opts;
+    serial_opts.num_threads = 0;
+
+    // Each statement is parsed along with the semicolon that ends it. Some
+    // tokenizers read past the end of a token to make sure it is followed by a
+    // separator (X'0F'; doesn't lex, for instance), so they must see exactly
+    // the bytes they would in the whole input.
+    std::vector<batch_input_t> inputs;
+    inputs.reserve(ranges.size());
+    for (const statement_range_t& r : ranges) {
+        const char* stmt_end = scan_skip_space(start + r.offset + r.len, end);
+        if (stmt_end != end)
+            stmt_end++;
+        inputs.push_back(batch_input_t{start + r.offset,
+                static_cast<size_t>(stmt_end - (start + r.offset))});
+    }
+    batch_result_t batch = parse_batch(inputs.data(), inputs.size(),
+            serial_opts, opts.num_threads);
+
+    for (size_t x = 0; x < ranges.size(); x++) {
+        parse_result_t& piece = batch.results[x];
+        if (piece.code != PARSE_OK) {
+            // The lexer only starts from its cursor when it lexes on demand,
+            // and neither the token array nor the structural index changes
+            // what parses, so we do without them here
+            serial_opts.tokenize_once = false;
+            serial_opts.structural_index = false;
+            parse_context_t ctx(res, serial_opts, start, end, padded, handler);
+            ctx.origin = origin;
+            ctx.lexer.cursor = start + ranges[x].offset;
+            parse_statements(ctx);
+            return;
+        }
+        for (std::unique_ptr<statement_t>& stmt : piece.statements) {
+            if (handler == nullptr) {
+                res.statements.emplace_back(std::move(stmt));
+                continue;
+            }
+            if (! (*handler)(stmt))
+                return;
+        }
+    }
+}
+
+parse_result_t parse(parse_input_t& subject) {
+    parse_options_t opts = default_options();
+    return parse(subject, opts);
+}
+
+parse_result_t parse(parse_input_t& subject, parse_options_t& opts) {
+    return parse_range(subject.data(), subject.data() + subject.size(), false,
+            opts, nullptr);
+}
+
+parse_result_t parse(
+        parse_input_t& subject,
+        parse_options_t& opts,
+        statement_handler_t handler) {
+    return parse_range(subject.data(), subject.data() + subject.size(), false,
+            opts, &handler);
+}
+
+parse_result_t parse(const char* subject, size_t len) {
+    parse_options_t opts = default_options();
+    return parse(subject, len, opts);
+}
+
+parse_result_t parse(const char* subject, size_t len, parse_options_t& opts) {
+    return parse_range(subject, subject + len, false, opts, nullptr);
+}
+
+parse_result_t parse(
+        const char* subject,
+        size_t len,
+        parse_options_t& opts,
+        statement_handler_t handler) {
+    return parse_range(subject, subject + len, false, opts, &handler);
+}
+
+parse_result_t parse_at(
+        const char* subject,
+        size_t len,
+        parse_options_t& opts,
+        statement_handler_t handler,
+        const line_origin_t& origin) {
+    return parse_range(subject, subject + len, false, opts, &handler, origin);
+}
+
+parser::parser() :
+    opts(default_options()),
+    state(std::make_unique<parser_state_t>())
+{
+    result.code = PARSE_OK;
+}
+
+parser::parser(parse_options_t& opts) :
+    opts(opts),
+    state(std::make_unique<parser_state_t>())
+{
+    result.code = PARSE_OK;
+}
+
+parser::~parser() {}
+
+void parser::reset() {
+    result.code = PARSE_OK;
+    result.error.clear();
+    result.syntax_error = syntax_error_t();
+    result.statements.clear();
+}
+
+parse_result_t& parser::parse(const char* subject, size_t len) {
+    reset();
+    // The statements parsed on other threads are moved into our result, so
+    // that the result's statement vector and error string keep their
+    // capacity however the input is parsed
+    parse_range_into(result, subject, subject + len, false, opts, nullptr,
+            line_origin_t(), state.get());
+    return result;
+}
+
+parse_result_t& parser::parse(parse_input_t& subject) {
+    return parse(subject.data(), subject.size());
+}
+
+parse_result_t parse(padded_input_t& subject) {
+    parse_options_t opts = default_options();
+    return parse(subject, opts);
+}
+
+parse_result_t parse(padded_input_t& subject, parse_options_t& opts) {
+    return parse_range(subject.cbegin(), subject.cend(), true, opts, nullptr);
+}
+
 } // namespace sqltoast
@@ -19,6 +19,17 @@ typedef bool (*parse_func_t) (
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out);
 
+// Parses the len bytes of SQL starting at subject just as parse() does, but
+// gives the line and column of a syntax error as if the input began at the
+// supplied origin of some larger input. parse_stream() uses this to report
+// errors in the stream's lines instead of those of the statement.
+parse_result_t parse_at(
+        const char* subject,
+        size_t len,
+        parse_options_t& opts,
+        statement_handler_t handler,
+        const line_origin_t& origin);
+
 // Top-level statement parser that is called from within the primary parse()
 // loop over found tokens.
 void parse_statement(parse_context_t& ctx);
@@ -79,6 +79,34 @@ ensure_term:
     goto optional_and;
 }
 
+// Returns true if the structural index shows that the parenthesized
+// expression opened by the supplied token is followed by a symbol that ends a
+// boolean factor. Such an expression can't be the left side of a predicate,
+// which needs an operator after it, and so must be a nested search condition.
+static bool parens_end_boolean_factor(
+        parse_context_t& ctx,
+        const token_t& lparen) {
+    const char* rparen = ctx.structure.matching_paren(lparen.lexeme.start);
+    if (rparen == nullptr)
+        return false;
+    // Make sure the lexer agrees that the parenthesis is a token of its own
+    symbol_t sym;
+    parse_position_t after = ctx.lexer.peek_from(rparen, &sym);
+    if (sym != SYMBOL_RPAREN || after != (rparen + 1))
+        return false;
+    ctx.lexer.peek_from(after, &sym);
+    switch (sym) {
+        case SYMBOL_AND:
+        case SYMBOL_OR:
+        case SYMBOL_RPAREN:
+        case SYMBOL_SEMICOLON:
+        case SYMBOL_EOS:
+            return true;
+        default:
+            return false;
+    }
+}
+
 // <boolean factor> ::= [ NOT ] <boolean test>
 //
 // <boolean test> ::= <boolean primary> [ IS [ NOT ] <truth value> ]
@@ -89,8 +117,6 @@ bool parse_boolean_factor(
         token_t& cur_tok,
         std::unique_ptr<boolean_factor_t>& out) {
     lexer_t& lex = ctx.lexer;
-    token_t start_tok = cur_tok;
-    parse_position_t start = lex.cursor;
     symbol_t cur_sym = cur_tok.symbol;
     std::unique_ptr<predicate_t> predicate;
     std::unique_ptr<search_condition_t> search_cond;
@@ -101,15 +127,19 @@ bool parse_boolean_factor(
         cur_tok = lex.next();
         reverse_op = true;
     }
+    // A failed predicate rewinds to the boolean test, after any NOT, so that
+    // NOT ( <search condition> ) is recognized
+    lexer_checkpoint_t start = lex.checkpoint();
+    if (cur_tok.symbol == SYMBOL_LPAREN &&
+            ! ctx.structure.empty() && parens_end_boolean_factor(ctx, cur_tok))
+        goto try_nested_search_condition;
     goto try_predicate;
 try_predicate:
     if (parse_predicate(ctx, cur_tok, predicate))
         goto push_factor;
     // rewind and try the nested search condition
-    ctx.result.code = PARSE_OK;
-    ctx.result.error.assign("");
-    cur_tok = start_tok;
-    lex.cursor = start;
+    clear_syntax_error(ctx);
+    lex.rewind(start);
     goto try_nested_search_condition;
 try_nested_search_condition:
     cur_sym = cur_tok.symbol;
@@ -315,10 +345,9 @@ err_expect_right:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find a << row value constructor >> for "
-                "the right side of the comparison predicate." << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find a << row value constructor >> for the right "
+                "side of the comparison predicate");
         return false;
     }
 expect_subquery:
@@ -345,11 +374,9 @@ err_expect_subquery:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find a << table subquery >> for "
-                "the right side of the quantified comparison predicate."
-             << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find a << table subquery >> for the right side "
+                "of the quantified comparison predicate");
         return false;
     }
 push_condition:
@@ -397,20 +424,18 @@ err_expect_left_comp:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find a << row value constructor >> for "
-                "the left comparison side of the between predicate." << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find a << row value constructor >> for the left "
+                "comparison side of the between predicate");
         return false;
     }
 err_expect_right_comp:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find a << row value constructor >> for "
-                "the right comparison side of the between predicate." << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find a << row value constructor >> for the right "
+                "comparison side of the between predicate");
         return false;
     }
 push_condition:
@@ -550,11 +575,9 @@ err_expect_value_expression:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find a <value expression> as "
-                "an element of the IN operator but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find a <value expression> as an element of the "
+                "IN operator");
         return false;
     }
 expect_rparen:
@@ -605,10 +628,8 @@ err_expect_subquery:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find a <subquery> after EXISTS "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find a <subquery> after EXISTS");
         return false;
     }
 err_expect_rparen:
@@ -650,10 +671,8 @@ err_expect_subquery:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find a <subquery> after UNIQUE "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find a <subquery> after UNIQUE");
         return false;
     }
 err_expect_rparen:
@@ -746,13 +765,9 @@ bool parse_overlaps_predicate(
         goto err_expect_rvc;
     goto push_predicate;
 err_expect_rvc:
-    {
-        std::stringstream estr;
-        estr << "Expected to find a <row value constructor> after OVERLAPS "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected to find a <row value constructor> after OVERLAPS");
+    return false;
 push_predicate:
     if (ctx.opts.disable_statement_construction)
         return true;
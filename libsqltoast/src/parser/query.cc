@@ -4,8 +4,10 @@
  * See the COPYING file in the root project directory for full text.
  */
 
+#include "parser/batch.h"
 #include "parser/error.h"
 #include "parser/parse.h"
+#include "parser/scan.h"
 
 namespace sqltoast {
 
@@ -25,8 +27,7 @@ bool parse_query_expression(
         token_t& cur_tok,
         std::unique_ptr<query_expression_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = lex.cursor;
-    token_t start_tok = lex.current_token;
+    lexer_checkpoint_t start = lex.checkpoint();
     std::unique_ptr<table_reference_t> joined_table;
 
     if (parse_non_join_query_expression(ctx, cur_tok, out))
@@ -35,8 +36,7 @@ bool parse_query_expression(
         return false;
 
     // Reset cursor to before parsing of joined table attempt.
-    lex.cursor = start;
-    lex.current_token = cur_tok = start_tok;
+    lex.rewind(start);
     if (! parse_joined_table(ctx, cur_tok, joined_table))
         return false;
     if (ctx.opts.disable_statement_construction)
@@ -98,8 +98,7 @@ bool parse_non_join_query_primary(
         token_t& cur_tok,
         std::unique_ptr<non_join_query_primary_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = lex.cursor;
-    token_t start_tok = lex.current_token;
+    lexer_checkpoint_t start = lex.checkpoint();
     std::unique_ptr<query_specification_t> query_spec;
     std::unique_ptr<table_value_constructor_t> tvc;
 
@@ -108,8 +107,7 @@ bool parse_non_join_query_primary(
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     // Reset cursor to before parsing of joined table attempt.
-    lex.cursor = start;
-    lex.current_token = cur_tok = start_tok;
+    lex.rewind(start);
     if (! parse_table_value_constructor(ctx, cur_tok, tvc))
         return false;
     // TODO(jaypipes): explicit table
@@ -123,6 +121,122 @@ push_primary:
     return true;
 }
 
+// The number of rows of a VALUES list that a thread parses at a time when
+// parsing the list on several threads. Lists with fewer than two chunks'
+// worth of rows are always parsed serially.
+static const size_t TVC_ROWS_PER_CHUNK = 1024;
+
+// The bytes of one row of a VALUES list, from its left paren to just after its
+// right paren
+typedef struct row_span {
+    const char* start;
+    const char* end;
+} row_span_t;
+
+// Uses the structural index to find the run of rows starting at the supplied
+// left paren that are parenthesized lists separated by nothing but commas and
+// whitespace. Rows that continue after their right paren, such as (1) + 2,
+// end the run.
+static void find_rows(
+        const structural_index_t& structure,
+        const char* lparen,
+        const char* end,
+        std::vector<row_span_t>& rows) {
+    const std::vector<uint32_t>& offsets = structure.offsets;
+    uint32_t x = structure.find(lparen);
+    while (x != STRUCTURE_NO_MATCH && structure.start[offsets[x]] == '(') {
+        const uint32_t close = structure.matches[x];
+        if (close == STRUCTURE_NO_MATCH)
+            return;
+        const char* rparen = structure.start + offsets[close];
+        rows.push_back(row_span_t{structure.start + offsets[x], rparen + 1});
+        // The row must be followed by a comma and the next row's left paren
+        if ((close + 2) >= offsets.size())
+            return;
+        const char* comma = structure.start + offsets[close + 1];
+        const char* next = structure.start + offsets[close + 2];
+        if (*comma != ',' || *next != '(' ||
+                scan_skip_space(rparen + 1, end) != comma ||
+                scan_skip_space(comma + 1, end) != next)
+            return;
+        x = close + 2;
+    }
+}
+
+// Parses the rows in [start, end) as if they were the whole input. Returns
+// false if they don't all parse as row value constructors separated by
+// commas.
+static bool parse_row_chunk(
+        const char* start,
+        const char* end,
+        parse_options_t& opts,
+        std::vector<std::unique_ptr<row_value_constructor_t>>& rows) {
+    parse_result_t res;
+    res.code = PARSE_OK;
+    parse_context_t ctx(res, opts, start, end, false, nullptr);
+    lexer_t& lex = ctx.lexer;
+    if (opts.tokenize_once)
+        lex.tokenize();
+    token_t& cur_tok = lex.current_token;
+    std::unique_ptr<row_value_constructor_t> row;
+    cur_tok = lex.next();
+    for (;;) {
+        if (! parse_row_value_constructor(ctx, cur_tok, row))
+            return false;
+        rows.emplace_back(std::move(row));
+        if (cur_tok.symbol == SYMBOL_EOS)
+            return res.code == PARSE_OK;
+        if (cur_tok.symbol != SYMBOL_COMMA)
+            return false;
+        cur_tok = lex.next();
+    }
+}
+
+// Parses the run of rows starting at the current token on several threads and
+// adds them to the supplied list, leaving the current token as the one after
+// the last row parsed. Returns false, without touching the list or the lexer,
+// if there aren't enough rows to be worth it or if any of them fail to parse,
+// in which case the caller parses the rows one at a time. That way a syntax
+// error is always reported exactly as it is when parsing serially.
+static bool parse_rows_parallel(
+        parse_context_t& ctx,
+        token_t& cur_tok,
+        std::vector<std::unique_ptr<row_value_constructor_t>>& val_list) {
+    if (ctx.opts.num_threads < 2 || ctx.structure.empty() ||
+            cur_tok.symbol != SYMBOL_LPAREN)
+        return false;
+    lexer_t& lex = ctx.lexer;
+    std::vector<row_span_t> rows;
+    find_rows(ctx.structure, cur_tok.lexeme.start, lex.end, rows);
+    const size_t num_chunks = rows.size() / TVC_ROWS_PER_CHUNK;
+    if (num_chunks < 2)
+        return false;
+
+    // Any rows left over after the last whole chunk are parsed serially
+    parse_options_t chunk_opts = ctx.opts;
+    chunk_opts.num_threads = 0;
+    std::vector<std::vector<std::unique_ptr<row_value_constructor_t>>> chunks(
+            num_chunks);
+    std::unique_ptr<bool[]> parsed(new bool[num_chunks]);
+    run_batch(num_chunks, ctx.opts.num_threads, [&](size_t x) {
+        const row_span_t& first = rows[x * TVC_ROWS_PER_CHUNK];
+        const row_span_t& last = rows[((x + 1) * TVC_ROWS_PER_CHUNK) - 1];
+        parsed[x] = parse_row_chunk(first.start, last.end, chunk_opts,
+                chunks[x]);
+    });
+    for (size_t x = 0; x < num_chunks; x++)
+        if (! parsed[x])
+            return false;
+
+    val_list.reserve(val_list.size() + (num_chunks * TVC_ROWS_PER_CHUNK));
+    for (auto& chunk : chunks)
+        for (auto& row : chunk)
+            val_list.emplace_back(std::move(row));
+    lex.seek(rows[(num_chunks * TVC_ROWS_PER_CHUNK) - 1].end);
+    cur_tok = lex.next();
+    return true;
+}
+
 //  <table value constructor> ::=
 //      VALUES <table value constructor list>
 //
@@ -142,11 +256,15 @@ bool parse_table_value_constructor(
     if (cur_sym != SYMBOL_VALUES)
         return false;
     cur_tok = lex.next();
+    if (parse_rows_parallel(ctx, cur_tok, val_list))
+        goto optional_comma;
     goto process_value_list_item;
 process_value_list_item:
     if (! parse_row_value_constructor(ctx, cur_tok, val_list_item))
         goto err_expect_value_item;
     val_list.emplace_back(std::move(val_list_item));
+    goto optional_comma;
+optional_comma:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COMMA) {
         cur_tok = lex.next();
@@ -154,12 +272,8 @@ process_value_list_item:
     }
     goto push_tvc;
 err_expect_value_item:
-    {
-        std::stringstream estr;
-        estr << "Expected a value item, but got " << cur_tok << "." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected a value item");
+    return false;
 push_tvc:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -176,8 +290,7 @@ bool parse_joined_table(
         token_t& cur_tok,
         std::unique_ptr<table_reference_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = lex.cursor;
-    token_t start_tok = lex.current_token;
+    lexer_checkpoint_t start = lex.checkpoint();
     symbol_t cur_sym = cur_tok.symbol;
     join_type_t join_type = JOIN_TYPE_NONE;
     std::unique_ptr<join_target_t> join_target;
@@ -192,8 +305,7 @@ bool parse_joined_table(
     // Reset cursor to before parsing of table reference attempt. If the next
     // symbol is a LPAREN, pop it and try parsing a parens-enclosed
     // joined_table construct
-    lex.cursor = start;
-    lex.current_token = cur_tok = start_tok;
+    lex.rewind(start);
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_LPAREN)
         return false;
@@ -262,13 +374,8 @@ err_expect_join:
     expect_error(ctx, SYMBOL_JOIN);
     return false;
 err_expect_table_reference:
-    {
-        std::stringstream estr;
-        estr << "Expected <table reference> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <table reference>");
+    return false;
 optional_join_specification:
     // We get here after successfully parsing an INNER or OUTER symbol followed
     // by a JOIN symbol and a <table reference>. We now must check for the
@@ -291,13 +398,8 @@ process_join_condition:
         goto err_expect_join_condition;
     goto push_joined_table;
 err_expect_join_condition:
-    {
-        std::stringstream estr;
-        estr << "Expected <join condition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <join condition>");
+    return false;
 process_named_columns:
     // We get here after parsing a USING symbol, which must be followed by a
     // parens-enclosed list of column identifiers
@@ -0,0 +1,461 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "parser/scan.h"
+
+#if defined(SQLTOAST_HAVE_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+namespace sqltoast {
+
+typedef struct scan_funcs {
+    const char* (*skip_space)(const char* cur, const char* end);
+    const char* (*skip_space_padded)(const char* cur, const char* end);
+    const char* (*find_byte)(const char* cur, const char* end, const char c);
+    const char* (*find_byte_padded)(
+            const char* cur,
+            const char* end,
+            const char c);
+    const char* (*find_byte2)(
+            const char* cur,
+            const char* end,
+            const char a,
+            const char b);
+    const char* (*find_split_byte)(const char* cur, const char* end);
+    void (*index_byte)(
+            const char* cur,
+            const char* end,
+            const char c,
+            const char* base,
+            std::vector<size_t>& offsets);
+} scan_funcs_t;
+
+static const char* skip_space_portable(const char* cur, const char* end) {
+    while (cur != end && char_is_space(*cur))
+        cur++;
+    return cur;
+}
+
+static const char* find_byte_portable(const char* cur, const char* end, const char c) {
+    while (cur != end && *cur != c)
+        cur++;
+    return cur;
+}
+
+static const char* find_byte2_portable(
+        const char* cur,
+        const char* end,
+        const char a,
+        const char b) {
+    while (cur != end && *cur != a && *cur != b)
+        cur++;
+    return cur;
+}
+
+static inline bool is_split_byte(const char c) {
+    switch (c) {
+        case ';':
+        case '\'':
+        case '"':
+        case '`':
+        case '-':
+        case '/':
+            return true;
+        default:
+            return false;
+    }
+}
+
+static const char* find_split_byte_portable(const char* cur, const char* end) {
+    while (cur != end && ! is_split_byte(*cur))
+        cur++;
+    return cur;
+}
+
+static void index_byte_portable(
+        const char* cur,
+        const char* end,
+        const char c,
+        const char* base,
+        std::vector<size_t>& offsets) {
+    for (; cur != end; cur++)
+        if (*cur == c)
+            offsets.push_back(cur - base);
+}
+
+static const scan_funcs_t scan_funcs_portable = {
+    &skip_space_portable,
+    &skip_space_portable,
+    &find_byte_portable,
+    &find_byte_portable,
+    &find_byte2_portable,
+    &find_split_byte_portable,
+    &index_byte_portable
+};
+
+#if defined(SQLTOAST_HAVE_X86_SIMD)
+
+// Returns a bitmask with a bit set for each whitespace byte in the vector.
+// Besides the space character, whitespace is the contiguous range of control
+// characters from \t (0x09) to \r (0x0D), which we check for with a single
+// unsigned min/compare after shifting the range down to [0, 4].
+static inline uint32_t space_mask_sse2(const __m128i v) {
+    const __m128i sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    const __m128i off = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+    const __m128i ctl = _mm_cmpeq_epi8(_mm_min_epu8(off, _mm_set1_epi8(4)), off);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(sp, ctl)));
+}
+
+static const char* skip_space_sse2(const char* cur, const char* end) {
+    while (end - cur >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const uint32_t mask = ~space_mask_sse2(v) & 0xFFFF;
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 16;
+    }
+    return skip_space_portable(cur, end);
+}
+
+// The padding after end is never whitespace, so the scan always stops at or
+// before end
+static const char* skip_space_padded_sse2(const char* cur, const char* end) {
+    for (;;) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const uint32_t mask = ~space_mask_sse2(v) & 0xFFFF;
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 16;
+    }
+}
+
+static const char* find_byte_sse2(const char* cur, const char* end, const char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    while (end - cur >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 16;
+    }
+    return find_byte_portable(cur, end, c);
+}
+
+static const char* find_byte2_sse2(
+        const char* cur,
+        const char* end,
+        const char a,
+        const char b) {
+    const __m128i needle_a = _mm_set1_epi8(a);
+    const __m128i needle_b = _mm_set1_epi8(b);
+    while (end - cur >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const __m128i found = _mm_or_si128(
+                _mm_cmpeq_epi8(v, needle_a), _mm_cmpeq_epi8(v, needle_b));
+        const uint32_t mask = _mm_movemask_epi8(found);
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 16;
+    }
+    return find_byte2_portable(cur, end, a, b);
+}
+
+static const char* find_byte_padded_sse2(
+        const char* cur,
+        const char* end,
+        const char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    while (cur < end) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if (mask != 0) {
+            const char* found = cur + __builtin_ctz(mask);
+            return found < end ? found : end;
+        }
+        cur += 16;
+    }
+    return end;
+}
+
+// Returns a bitmask with a bit set for each byte in the vector for which
+// is_split_byte() is true
+static inline uint32_t split_mask_sse2(const __m128i v) {
+    const __m128i a = _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8(';')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+    const __m128i b = _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('`')));
+    const __m128i c = _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('-')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('/')));
+    return static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), c)));
+}
+
+static const char* find_split_byte_sse2(const char* cur, const char* end) {
+    while (end - cur >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        const uint32_t mask = split_mask_sse2(v);
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 16;
+    }
+    return find_split_byte_portable(cur, end);
+}
+
+// Appends the offset of every set bit in the mask, from the supplied position
+static inline void push_mask_offsets(
+        uint32_t mask,
+        size_t at,
+        std::vector<size_t>& offsets) {
+    while (mask != 0) {
+        offsets.push_back(at + __builtin_ctz(mask));
+        mask &= mask - 1;
+    }
+}
+
+static void index_byte_sse2(
+        const char* cur,
+        const char* end,
+        const char c,
+        const char* base,
+        std::vector<size_t>& offsets) {
+    const __m128i needle = _mm_set1_epi8(c);
+    while (end - cur >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        push_mask_offsets(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)),
+                cur - base, offsets);
+        cur += 16;
+    }
+    index_byte_portable(cur, end, c, base, offsets);
+}
+
+static const scan_funcs_t scan_funcs_sse2 = {
+    &skip_space_sse2,
+    &skip_space_padded_sse2,
+    &find_byte_sse2,
+    &find_byte_padded_sse2,
+    &find_byte2_sse2,
+    &find_split_byte_sse2,
+    &index_byte_sse2
+};
+
+__attribute__((target("avx2")))
+static const char* skip_space_avx2(const char* cur, const char* end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i four = _mm256_set1_epi8(4);
+    while (end - cur >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        const __m256i sp = _mm256_cmpeq_epi8(v, space);
+        const __m256i off = _mm256_sub_epi8(v, tab);
+        const __m256i ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(off, four), off);
+        const uint32_t mask = ~static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_or_si256(sp, ctl)));
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 32;
+    }
+    return skip_space_sse2(cur, end);
+}
+
+__attribute__((target("avx2")))
+static const char* skip_space_padded_avx2(const char* cur, const char* end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i four = _mm256_set1_epi8(4);
+    for (;;) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        const __m256i sp = _mm256_cmpeq_epi8(v, space);
+        const __m256i off = _mm256_sub_epi8(v, tab);
+        const __m256i ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(off, four), off);
+        const uint32_t mask = ~static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_or_si256(sp, ctl)));
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 32;
+    }
+}
+
+__attribute__((target("avx2")))
+static const char* find_byte_avx2(const char* cur, const char* end, const char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (end - cur >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        const uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 32;
+    }
+    return find_byte_sse2(cur, end, c);
+}
+
+__attribute__((target("avx2")))
+static const char* find_byte2_avx2(
+        const char* cur,
+        const char* end,
+        const char a,
+        const char b) {
+    const __m256i needle_a = _mm256_set1_epi8(a);
+    const __m256i needle_b = _mm256_set1_epi8(b);
+    while (end - cur >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        const __m256i found = _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, needle_a), _mm256_cmpeq_epi8(v, needle_b));
+        const uint32_t mask = _mm256_movemask_epi8(found);
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 32;
+    }
+    return find_byte2_sse2(cur, end, a, b);
+}
+
+__attribute__((target("avx2")))
+static const char* find_byte_padded_avx2(
+        const char* cur,
+        const char* end,
+        const char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (cur < end) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        const uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle));
+        if (mask != 0) {
+            const char* found = cur + __builtin_ctz(mask);
+            return found < end ? found : end;
+        }
+        cur += 32;
+    }
+    return end;
+}
+
+__attribute__((target("avx2")))
+static const char* find_split_byte_avx2(const char* cur, const char* end) {
+    const __m256i semicolon = _mm256_set1_epi8(';');
+    const __m256i quote = _mm256_set1_epi8('\'');
+    const __m256i double_quote = _mm256_set1_epi8('"');
+    const __m256i backtick = _mm256_set1_epi8('`');
+    const __m256i dash = _mm256_set1_epi8('-');
+    const __m256i slash = _mm256_set1_epi8('/');
+    while (end - cur >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        const __m256i a = _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, semicolon), _mm256_cmpeq_epi8(v, quote));
+        const __m256i b = _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, double_quote),
+                _mm256_cmpeq_epi8(v, backtick));
+        const __m256i c = _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, dash), _mm256_cmpeq_epi8(v, slash));
+        const uint32_t mask = _mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_or_si256(a, b), c));
+        if (mask != 0)
+            return cur + __builtin_ctz(mask);
+        cur += 32;
+    }
+    return find_split_byte_sse2(cur, end);
+}
+
+__attribute__((target("avx2")))
+static void index_byte_avx2(
+        const char* cur,
+        const char* end,
+        const char c,
+        const char* base,
+        std::vector<size_t>& offsets) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (end - cur >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        push_mask_offsets(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)),
+                cur - base, offsets);
+        cur += 32;
+    }
+    index_byte_sse2(cur, end, c, base, offsets);
+}
+
+static const scan_funcs_t scan_funcs_avx2 = {
+    &skip_space_avx2,
+    &skip_space_padded_avx2,
+    &find_byte_avx2,
+    &find_byte_padded_avx2,
+    &find_byte2_avx2,
+    &find_split_byte_avx2,
+    &index_byte_avx2
+};
+
+#endif // defined(SQLTOAST_HAVE_X86_SIMD)
+
+static const scan_funcs_t* select_scan_funcs() {
+#if defined(SQLTOAST_HAVE_X86_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return &scan_funcs_avx2;
+    // SSE2 is part of the x86-64 baseline
+    return &scan_funcs_sse2;
+#else
+    return &scan_funcs_portable;
+#endif
+}
+
+// The scanner implementations are selected the first time any scan is
+// performed. Racing threads will all select the same implementation, so a
+// relaxed atomic is all we need here.
+static std::atomic<const scan_funcs_t*> scan_funcs(nullptr);
+
+static inline const scan_funcs_t& get_scan_funcs() {
+    const scan_funcs_t* funcs = scan_funcs.load(std::memory_order_relaxed);
+    if (funcs == nullptr) {
+        funcs = select_scan_funcs();
+        scan_funcs.store(funcs, std::memory_order_relaxed);
+    }
+    return *funcs;
+}
+
+const char* scan_skip_space(const char* cur, const char* end) {
+    return get_scan_funcs().skip_space(cur, end);
+}
+
+const char* scan_skip_space_padded(const char* cur, const char* end) {
+    return get_scan_funcs().skip_space_padded(cur, end);
+}
+
+const char* scan_find_byte(const char* cur, const char* end, const char c) {
+    return get_scan_funcs().find_byte(cur, end, c);
+}
+
+const char* scan_find_byte_padded(
+        const char* cur,
+        const char* end,
+        const char c) {
+    return get_scan_funcs().find_byte_padded(cur, end, c);
+}
+
+const char* scan_find_byte2(
+        const char* cur,
+        const char* end,
+        const char a,
+        const char b) {
+    return get_scan_funcs().find_byte2(cur, end, a, b);
+}
+
+const char* scan_find_split_byte(const char* cur, const char* end) {
+    return get_scan_funcs().find_split_byte(cur, end);
+}
+
+void scan_index_byte(
+        const char* cur,
+        const char* end,
+        const char c,
+        const char* base,
+        std::vector<size_t>& offsets) {
+    get_scan_funcs().index_byte(cur, end, c, base, offsets);
+}
+
+} // namespace sqltoast
@@ -0,0 +1,79 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_SCAN_H
+#define SQLTOAST_PARSER_SCAN_H
+
+#include <cstddef>
+#include <vector>
+
+#include "parser/char_class.h"
+
+// Byte-scanning primitives used by the lexer to move over long runs of input
+// that cannot contain a token boundary, such as whitespace, comments and the
+// contents of quoted strings and delimited identifiers. On x86-64 these scan
+// 16 (SSE2) or 32 (AVX2) bytes at a time, with the widest available
+// instruction set chosen at run time the first time a scan is performed.
+// Elsewhere, a portable byte-at-a-time implementation is used.
+//
+// All scanners are bounded by the supplied end pointer. The plain scanners
+// never read at or past it. The _padded scanners require at least
+// SCAN_PADDING readable bytes after end, none of which is whitespace (a
+// padded_input_t's zero bytes, for instance), and in exchange read whole
+// vectors right up to end with no byte-at-a-time tail.
+//
+// Building with -DSQLTOAST_SIMD=OFF defines SQLTOAST_NO_SIMD and forces the
+// portable implementation.
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && \
+    ! defined(SQLTOAST_NO_SIMD)
+#define SQLTOAST_HAVE_X86_SIMD 1
+#endif
+
+namespace sqltoast {
+
+// The number of bytes past the end of the input that the _padded scanners may
+// read
+const size_t SCAN_PADDING = 32;
+
+// Returns a pointer to the first non-whitespace byte in [cur, end) or end if
+// every byte is whitespace. Whitespace is as defined by char_is_space().
+const char* scan_skip_space(const char* cur, const char* end);
+const char* scan_skip_space_padded(const char* cur, const char* end);
+
+// Returns a pointer to the first occurrence of the supplied byte in [cur,
+// end) or end if the byte is not found
+const char* scan_find_byte(const char* cur, const char* end, const char c);
+const char* scan_find_byte_padded(
+        const char* cur,
+        const char* end,
+        const char c);
+
+// Returns a pointer to the first occurrence of either of the supplied bytes in
+// [cur, end) or end if neither byte is found
+const char* scan_find_byte2(
+        const char* cur,
+        const char* end,
+        const char a,
+        const char b);
+
+// Returns a pointer to the first byte in [cur, end) that may end a statement
+// or begin a string literal, delimited identifier or comment (one of ;'"`-/)
+// or end if there is no such byte
+const char* scan_find_split_byte(const char* cur, const char* end);
+
+// Appends to offsets the offset from base of every occurrence of the supplied
+// byte in [cur, end), in input order
+void scan_index_byte(
+        const char* cur,
+        const char* end,
+        const char c,
+        const char* base,
+        std::vector<size_t>& offsets);
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_SCAN_H */
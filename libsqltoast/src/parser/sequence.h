@@ -8,6 +8,7 @@
 #define SQLTOAST_PARSER_SEQUENCE_H
 
 #include "context.h"
+#include "error.h"
 #include "symbol.h"
 
 namespace sqltoast {
@@ -43,13 +44,8 @@ inline bool expect_sequence(parse_context_t& ctx, const symbol_t expected_sequen
     }
     return true;
 err_unexpected:
-    {
-        std::stringstream estr;
-        estr << "Expected " << exp_sym << " but found " << cur_sym;
-        estr << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_error(ctx, exp_sym);
+    return false;
 }
 
 } // namespace sqltoast
@@ -0,0 +1,152 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/scan.h"
+#include "parser/split.h"
+
+namespace sqltoast {
+
+const char* statement_splitter::find_end(
+        const char* cur,
+        const char* end,
+        bool* found) {
+    *found = false;
+    while (cur != end) {
+        switch (state) {
+            case SPLIT_STATE_NONE:
+                // Jump straight to the next byte that could end the
+                // statement or hide a semicolon from us
+                cur = scan_find_split_byte(cur, end);
+                if (cur == end)
+                    return end;
+                switch (*cur) {
+                    case ';':
+                        *found = true;
+                        return cur;
+                    case '\'':
+                        state = SPLIT_STATE_QUOTE;
+                        break;
+                    case '"':
+                        state = SPLIT_STATE_DOUBLE_QUOTE;
+                        break;
+                    case '`':
+                        state = SPLIT_STATE_BACKTICK;
+                        break;
+                    case '-':
+                        if ((cur + 1) == end)
+                            return cur;
+                        if (*(cur + 1) == '-') {
+                            state = SPLIT_STATE_LINE_COMMENT;
+                            cur++;
+                        }
+                        break;
+                    case '/':
+                        if ((cur + 1) == end)
+                            return cur;
+                        if (*(cur + 1) == '*') {
+                            state = SPLIT_STATE_BLOCK_COMMENT;
+                            cur++;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                cur++;
+                continue;
+            case SPLIT_STATE_QUOTE:
+                // Character string literals may contain backslash escapes
+                cur = scan_find_byte2(cur, end, '\'', '\\');
+                if (cur == end)
+                    return end;
+                if (*cur == '\\') {
+                    if ((cur + 1) == end)
+                        return cur;
+                    cur += 2;
+                    continue;
+                }
+                state = SPLIT_STATE_NONE;
+                cur++;
+                continue;
+            case SPLIT_STATE_DOUBLE_QUOTE:
+                cur = scan_find_byte(cur, end, '"');
+                if (cur == end)
+                    return end;
+                state = SPLIT_STATE_NONE;
+                cur++;
+                continue;
+            case SPLIT_STATE_BACKTICK:
+                cur = scan_find_byte(cur, end, '`');
+                if (cur == end)
+                    return end;
+                state = SPLIT_STATE_NONE;
+                cur++;
+                continue;
+            case SPLIT_STATE_LINE_COMMENT:
+                cur = scan_find_byte(cur, end, '\n');
+                if (cur == end)
+                    return end;
+                state = SPLIT_STATE_NONE;
+                cur++;
+                continue;
+            case SPLIT_STATE_BLOCK_COMMENT:
+                cur = scan_find_byte(cur, end, '*');
+                if (cur == end)
+                    return end;
+                if ((cur + 1) == end)
+                    return cur;
+                if (*(cur + 1) == '/') {
+                    state = SPLIT_STATE_NONE;
+                    cur += 2;
+                    continue;
+                }
+                cur++;
+                continue;
+        }
+    }
+    return end;
+}
+
+// Appends the range [start, end) to ranges, less any surrounding whitespace,
+// unless nothing but whitespace is left
+static void push_range(
+        std::vector<statement_range_t>& ranges,
+        const char* subject,
+        const char* start,
+        const char* end) {
+    start = scan_skip_space(start, end);
+    while (end != start && char_is_space(*(end - 1)))
+        end--;
+    if (start == end)
+        return;
+    ranges.push_back(statement_range_t{
+        static_cast<size_t>(start - subject),
+        static_cast<size_t>(end - start)});
+}
+
+std::vector<statement_range_t> split_statements(const char* subject, size_t len) {
+    std::vector<statement_range_t> ranges;
+    statement_splitter_t splitter;
+    const char* end = subject + len;
+    const char* start = subject;
+    bool found;
+    for (;;) {
+        const char* p = splitter.find_end(start, end, &found);
+        if (! found)
+            break;
+        push_range(ranges, subject, start, p);
+        start = p + 1;
+    }
+    push_range(ranges, subject, start, end);
+    return ranges;
+}
+
+std::vector<statement_range_t> split_statements(parse_input_t& subject) {
+    return split_statements(subject.data(), subject.size());
+}
+
+} // namespace sqltoast
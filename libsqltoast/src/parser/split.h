@@ -0,0 +1,49 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_SPLIT_H
+#define SQLTOAST_PARSER_SPLIT_H
+
+namespace sqltoast {
+
+// Where a statement splitter is within the input, with respect to the things
+// that may hide a semicolon from it
+typedef enum split_state {
+    SPLIT_STATE_NONE,
+    SPLIT_STATE_QUOTE, // inside a '' character string literal
+    SPLIT_STATE_DOUBLE_QUOTE, // inside a "" delimited identifier
+    SPLIT_STATE_BACKTICK, // inside a `` delimited identifier
+    SPLIT_STATE_LINE_COMMENT, // inside a -- comment
+    SPLIT_STATE_BLOCK_COMMENT // inside a /* */ comment
+} split_state_t;
+
+// Finds the semicolons that end SQL statements without lexing or parsing the
+// statements, skipping over semicolons inside string literals, delimited
+// identifiers and comments the same way the lexer does. The splitter keeps
+// its state between calls to find_end(), so input can be fed to it a piece at
+// a time.
+//
+// A doubled quote inside a literal or delimited identifier ('it''s') is simply
+// treated as the literal ending and another starting right after it, which has
+// the same effect on where statements end.
+typedef struct statement_splitter {
+    split_state_t state;
+    statement_splitter() :
+        state(SPLIT_STATE_NONE)
+    {}
+    // Scans [cur, end) for the semicolon that ends the current statement. If
+    // it is found, sets *found to true and returns a pointer to the
+    // semicolon. Otherwise sets *found to false and returns the position that
+    // scanning must resume from once more input follows end. This is end
+    // itself unless the last byte might begin a two-byte sequence like -- or
+    // /*, in which case it is the position of that byte. If end is truly the
+    // end of the input, the current statement simply ends there.
+    const char* find_end(const char* cur, const char* end, bool* found);
+} statement_splitter_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_SPLIT_H */
@@ -5,7 +5,6 @@
  */
 
 #include <iostream>
-#include <cctype>
 #include <sstream>
 
 #include "parser/error.h"
@@ -106,9 +105,8 @@ void parse_statement(parse_context_t& ctx) {
             break;
         default:
         {
-            std::stringstream estr;
-            estr << "Failed to recognize any valid SQL statement." << std::endl;
-            create_syntax_error_marker(ctx, estr);
+            invalid_syntax_error(ctx,
+                    "Failed to recognize any valid SQL statement.");
             return;
         }
     }
@@ -122,13 +120,20 @@ void parse_statement(parse_context_t& ctx) {
         // Already have a nicely-formatted error, so just return
         return;
     } else {
-        std::stringstream estr;
-        estr << "Failed to recognize any valid SQL statement." << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        invalid_syntax_error(ctx,
+                "Failed to recognize any valid SQL statement.");
+        return;
     }
 push_statement:
     if (ctx.opts.disable_statement_construction)
         return;
+    if (ctx.handler != nullptr) {
+        // Unless the handler takes ownership of the statement, it is
+        // destroyed as soon as the handler returns
+        if (! (*ctx.handler)(stmt_p))
+            ctx.stopped = true;
+        return;
+    }
     ctx.result.statements.emplace_back(std::move(stmt_p));
 }
 
@@ -51,7 +51,7 @@ bool parse_alter_table(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t table_name;
     lexeme_t column_name;
     lexeme_t constraint_name;
@@ -66,7 +66,7 @@ bool parse_alter_table(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_TABLE) {
         // rewind
-        ctx.lexer.cursor = start;
+        lex.rewind_cursor(start);
         return false;
     }
     cur_tok = lex.next();
@@ -115,13 +115,10 @@ process_add_actions:
             goto err_expect_add_column_or_constraint;
     }
 err_expect_add_column_or_constraint:
-    {
-        std::stringstream estr;
-        estr << "Expected either an add column action or an add "
-                "constraint action but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected either an add column action or an add constraint "
+            "action");
+    return false;
 process_add_column:
     if (ctx.opts.disable_statement_construction)
         goto statement_ending;
@@ -130,13 +127,8 @@ process_add_column:
     action = std::make_unique<add_column_action_t>(column_def);
     goto statement_ending;
 err_expect_column_definition:
-    {
-        std::stringstream estr;
-        estr << "Expected <column definition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <column definition>");
+    return false;
 process_add_constraint:
     if (ctx.opts.disable_statement_construction)
         goto statement_ending;
@@ -145,13 +137,8 @@ process_add_constraint:
     action = std::make_unique<add_constraint_action_t>(constraint);
     goto statement_ending;
 err_expect_constraint:
-    {
-        std::stringstream estr;
-        estr << "Expected <constraint definition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <constraint definition>");
+    return false;
 process_drop_actions:
     cur_sym = cur_tok.symbol;
     switch (cur_sym) {
@@ -167,13 +154,10 @@ process_drop_actions:
             goto err_expect_drop_column_or_constraint;
     }
 err_expect_drop_column_or_constraint:
-    {
-        std::stringstream estr;
-        estr << "Expected either a drop column action or a drop "
-                "constraint action but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected either a drop column action or a drop constraint "
+            "action");
+    return false;
 process_drop_column:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_COLUMN)
@@ -248,12 +232,8 @@ err_expect_default:
     expect_error(ctx, SYMBOL_DEFAULT);
     return false;
 err_expect_default_clause:
-    {
-        std::stringstream estr;
-        estr << "Expected <default clause> but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <default clause>");
+    return false;
 process_alter_column_drop_default_action:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_DEFAULT)
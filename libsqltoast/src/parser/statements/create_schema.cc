@@ -47,7 +47,7 @@ bool parse_create_schema(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t schema_name;
     lexeme_t authz_ident;
     lexeme_t default_charset;
@@ -62,7 +62,7 @@ bool parse_create_schema(
             goto identifier_or_authorization_clause;
         default:
             // rewind
-            ctx.lexer.cursor = start;
+            lex.rewind_cursor(start);
             return false;
     }
 
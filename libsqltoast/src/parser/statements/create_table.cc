@@ -30,7 +30,7 @@ bool parse_create_table(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t table_name;
     symbol_t cur_sym;
     table_type_t table_type = TABLE_TYPE_NORMAL;
@@ -53,7 +53,7 @@ bool parse_create_table(
             goto table_kw_or_table_type;
         default:
             // rewind
-            ctx.lexer.cursor = start;
+            lex.rewind_cursor(start);
             return false;
     }
 table_kw_or_table_type:
@@ -139,10 +139,8 @@ err_expect_column_def_or_constraint:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     else {
-        std::stringstream estr;
-        estr << "Expected either a column definition or a "
-                "constraint but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected either a column definition or a constraint");
         return false;
     }
 expect_table_list_close:
@@ -21,7 +21,7 @@ bool parse_create_view(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     symbol_t cur_sym = cur_tok.symbol;
     lexeme_t table_name;
     check_option_t check_option = CHECK_OPTION_NONE;
@@ -32,7 +32,7 @@ bool parse_create_view(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_VIEW) {
         // rewind
-        ctx.lexer.cursor = start;
+        lex.rewind_cursor(start);
         return false;
     }
     cur_tok = lex.next();
@@ -122,13 +122,8 @@ err_expect_option:
     expect_error(ctx, SYMBOL_OPTION);
     return false;
 err_expect_query_expression:
-    {
-        std::stringstream estr;
-        estr << "Expected to find <query expression> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected to find <query expression>");
+    return false;
 statement_ending:
     // We get here after successfully parsing the statement and now expect
     // either the end of parse content or a semicolon to indicate end of
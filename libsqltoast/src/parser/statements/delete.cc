@@ -23,14 +23,14 @@ bool parse_delete(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t table_name;
     symbol_t cur_sym;
     std::unique_ptr<search_condition_t> where_cond;
 
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_DELETE) {
-        ctx.lexer.cursor = start;
+        lex.rewind_cursor(start);
         return false;
     }
     cur_tok = lex.next();
@@ -25,7 +25,7 @@ bool parse_drop_schema(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t schema_name;
     symbol_t cur_sym;
     drop_behaviour_t behaviour = DROP_BEHAVIOUR_CASCADE;
@@ -38,7 +38,7 @@ bool parse_drop_schema(
             goto expect_identifier;
         default:
             // rewind
-            ctx.lexer.cursor = start;
+            lex.rewind_cursor(start);
             return false;
     }
 
@@ -14,7 +14,7 @@ bool parse_drop_view(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t table_name;
     symbol_t cur_sym;
     drop_behaviour_t behaviour = DROP_BEHAVIOUR_CASCADE;
@@ -23,7 +23,7 @@ bool parse_drop_view(
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_VIEW) {
         // rewind
-        ctx.lexer.cursor = start;
+        lex.rewind_cursor(start);
         return false;
     }
     cur_tok = lex.next();
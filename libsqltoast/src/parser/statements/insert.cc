@@ -25,7 +25,7 @@ bool parse_insert(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t table_name;
     symbol_t cur_sym;
     std::vector<lexeme_t> col_list;
@@ -33,7 +33,7 @@ bool parse_insert(
 
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_INSERT) {
-        ctx.lexer.cursor = start;
+        lex.rewind_cursor(start);
         return false;
     }
     cur_tok = lex.next();
@@ -105,12 +105,8 @@ expect_query_expression:
         goto err_expect_query_expression;
     goto statement_ending;
 err_expect_query_expression:
-    {
-        std::stringstream estr;
-        estr << "Expected a value item, but got " << cur_tok << "." << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected a value item");
+    return false;
 statement_ending:
     // We get here after successfully parsing the statement and now expect
     // either the end of parse content or a semicolon to indicate end of
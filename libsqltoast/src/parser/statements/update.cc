@@ -28,7 +28,7 @@ bool parse_update(
         token_t& cur_tok,
         std::unique_ptr<statement_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = ctx.lexer.cursor;
+    lexer_checkpoint_t start = lex.checkpoint();
     lexeme_t table_name;
     lexeme_t column_name;
     symbol_t cur_sym;
@@ -38,7 +38,7 @@ bool parse_update(
 
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_UPDATE) {
-        ctx.lexer.cursor = start;
+        lex.rewind_cursor(start);
         return false;
     }
     cur_tok = lex.next();
@@ -103,10 +103,9 @@ err_expect_value_null_or_default:
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     {
-        std::stringstream estr;
-        estr << "Expected to find NULL, DEFAULT or a << value expression >> for "
-                "WHERE clause." << std::endl;
-        create_syntax_error_marker(ctx, estr);
+        expect_construct_error(ctx,
+                "Expected to find NULL, DEFAULT or a << value expression >> "
+                "for WHERE clause");
         return false;
     }
 optional_where:
@@ -0,0 +1,275 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/char_class.h"
+#include "parser/lines.h"
+#include "parser/parse.h"
+#include "parser/split.h"
+
+namespace sqltoast {
+
+// Parses the statement in [start, end), which begins at the supplied offset,
+// line and column in the stream, and hands whatever was parsed to the
+// handler. Returns false if the stream should not be parsed any further.
+static bool parse_window_statement(
+        const char* start,
+        const char* end,
+        uint64_t offset,
+        const line_origin_t& origin,
+        stream_handler_t& handler,
+        parse_options_t& opts,
+        stream_result_t& res) {
+    bool stopped = false;
+    parse_result_t stmt_res = parse_at(start, end - start, opts,
+            [&](std::unique_ptr<statement_t>& stmt) {
+                res.statement_count++;
+                stopped = ! handler(*stmt);
+                return ! stopped;
+            }, origin);
+    if (stmt_res.code != PARSE_OK) {
+        res.code = stmt_res.code;
+        res.error = std::move(stmt_res.error);
+        const char* first = start;
+        while (first != end && char_is_space(*first))
+            first++;
+        res.error_offset = offset + (first - start);
+        return false;
+    }
+    return ! stopped;
+}
+
+// The input of a stream that has not yet been parsed. The buffer holds the
+// statement currently being read, starting at stmt_start, followed by any
+// unscanned input. The splitter resumes scanning at scan_from.
+typedef struct push_parser_state {
+    std::vector<char> buf;
+    statement_splitter_t splitter;
+    // The offset in the stream of the start of the buffer
+    uint64_t buf_offset;
+    // The line and column in the stream of the statement being read
+    line_origin_t stmt_origin;
+    size_t stmt_start;
+    size_t scan_from;
+    size_t filled;
+    push_parser_state() :
+        buf(),
+        splitter(),
+        buf_offset(0),
+        stmt_origin(),
+        stmt_start(0),
+        scan_from(0),
+        filled(0)
+    {}
+    // Parses every complete statement in the buffer. Returns false if the
+    // stream should not be parsed any further.
+    bool parse_complete(
+            stream_handler_t& handler,
+            parse_options_t& opts,
+            stream_result_t& res) {
+        while (scan_from < filled) {
+            const char* base = buf.data();
+            bool found;
+            const char* p = splitter.find_end(
+                    base + scan_from, base + filled, &found);
+            if (! found) {
+                scan_from = p - base;
+                break;
+            }
+            if (! parse_window_statement(base + stmt_start, p + 1,
+                        buf_offset + stmt_start, stmt_origin, handler, opts,
+                        res))
+                return false;
+            stmt_origin.advance(base + stmt_start, p + 1);
+            stmt_start = scan_from = (p + 1) - base;
+        }
+        return true;
+    }
+    // Parses the last statement in the stream, which need not end with a
+    // semicolon. Sets an input error if the stream was empty.
+    void parse_rest(
+            stream_handler_t& handler,
+            parse_options_t& opts,
+            stream_result_t& res) {
+        if (buf_offset == 0 && filled == 0) {
+            res.code = PARSE_INPUT_ERROR;
+            res.error.assign("Nothing to parse.");
+            return;
+        }
+        if (stmt_start < filled) {
+            const char* base = buf.data();
+            parse_window_statement(base + stmt_start, base + filled,
+                    buf_offset + stmt_start, stmt_origin, handler, opts, res);
+            stmt_start = scan_from = filled;
+        }
+    }
+    // Moves the partial statement to the front of the buffer and makes sure
+    // there are at least room bytes free after it. The buffer only grows if
+    // moving the statement doesn't leave enough room.
+    void make_room(size_t room) {
+        if (stmt_start > 0) {
+            memmove(buf.data(), buf.data() + stmt_start, filled - stmt_start);
+            buf_offset += stmt_start;
+            filled -= stmt_start;
+            scan_from -= stmt_start;
+            stmt_start = 0;
+        }
+        if ((buf.size() - filled) < room)
+            buf.resize(filled + room);
+    }
+} push_parser_state_t;
+
+stream_result_t parse_stream(
+        stream_reader_t reader,
+        stream_handler_t handler,
+        parse_options_t& opts,
+        size_t window_size) {
+    stream_result_t res;
+    res.code = PARSE_OK;
+    res.statement_count = 0;
+    res.error_offset = 0;
+    if (window_size == 0)
+        window_size = STREAM_WINDOW_SIZE;
+
+    push_parser_state_t in;
+    in.buf.resize(window_size);
+    bool eos = false;
+    for (;;) {
+        if (! in.parse_complete(handler, opts, res))
+            return res;
+        if (eos)
+            break;
+
+        in.make_room(window_size);
+        size_t nread = 0;
+        if (! reader(in.buf.data() + in.filled, in.buf.size() - in.filled,
+                    &nread)) {
+            res.code = PARSE_INPUT_ERROR;
+            res.error.assign("Failed to read input.");
+            res.error_offset = in.buf_offset + in.filled;
+            return res;
+        }
+        eos = (nread == 0);
+        in.filled += nread;
+    }
+    in.parse_rest(handler, opts, res);
+    return res;
+}
+
+stream_result_t parse_stream(
+        int fd,
+        stream_handler_t handler,
+        parse_options_t& opts,
+        size_t window_size) {
+    stream_reader_t reader = [fd](char* buf, size_t len, size_t* nread) {
+        for (;;) {
+            ssize_t n = read(fd, buf, len);
+            if (n >= 0) {
+                *nread = n;
+                return true;
+            }
+            if (errno != EINTR)
+                return false;
+        }
+    };
+    return parse_stream(reader, handler, opts, window_size);
+}
+
+stream_result_t parse_stream(int fd, stream_handler_t handler) {
+    parse_options_t opts = {
+        SQL_DIALECT_ANSI_1992,
+        false,
+        false,
+        false,
+        0
+    };
+
+    return parse_stream(fd, handler, opts, STREAM_WINDOW_SIZE);
+}
+
+static parse_options_t push_default_options() {
+    parse_options_t opts = {
+        SQL_DIALECT_ANSI_1992,
+        false,
+        false,
+        false,
+        0
+    };
+    return opts;
+}
+
+push_parser::push_parser(stream_handler_t handler) :
+    opts(push_default_options()),
+    handler(handler),
+    state(std::make_unique<push_parser_state_t>())
+{
+    reset();
+}
+
+push_parser::push_parser(parse_options_t& opts, stream_handler_t handler) :
+    opts(opts),
+    handler(handler),
+    state(std::make_unique<push_parser_state_t>())
+{
+    reset();
+}
+
+push_parser::~push_parser() {}
+
+void push_parser::reset() {
+    status = PUSH_NEED_MORE_INPUT;
+    result.code = PARSE_OK;
+    result.error.clear();
+    result.statement_count = 0;
+    result.error_offset = 0;
+    push_parser_state_t& in = *state;
+    in.splitter = statement_splitter_t();
+    in.buf_offset = 0;
+    in.stmt_origin = line_origin_t();
+    in.stmt_start = 0;
+    in.scan_from = 0;
+    in.filled = 0;
+}
+
+// Returns the status of a push parser that has parsed what it could of its
+// input
+static push_status_t push_status(const stream_result_t& res, bool done) {
+    switch (res.code) {
+        case PARSE_OK:
+            break;
+        case PARSE_SYNTAX_ERROR:
+            return PUSH_SYNTAX_ERROR;
+        default:
+            return PUSH_INPUT_ERROR;
+    }
+    return done ? PUSH_DONE : PUSH_NEED_MORE_INPUT;
+}
+
+push_status_t push_parser::feed(const char* chunk, size_t len) {
+    if (status != PUSH_NEED_MORE_INPUT)
+        return status;
+    push_parser_state_t& in = *state;
+    in.make_room(len);
+    memcpy(in.buf.data() + in.filled, chunk, len);
+    in.filled += len;
+    if (! in.parse_complete(handler, opts, result) && result.code == PARSE_OK)
+        return status = PUSH_STOPPED;
+    return status = push_status(result, false);
+}
+
+push_status_t push_parser::finish() {
+    if (status != PUSH_NEED_MORE_INPUT)
+        return status;
+    state->parse_rest(handler, opts, result);
+    return status = push_status(result, true);
+}
+
+} // namespace sqltoast
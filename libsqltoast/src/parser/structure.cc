@@ -0,0 +1,286 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "parser/scan.h"
+#include "parser/split.h"
+#include "parser/structure.h"
+
+#if defined(SQLTOAST_HAVE_X86_SIMD)
+#include <emmintrin.h>
+#endif
+
+namespace sqltoast {
+
+// The bytes of a 64-byte block of input that the indexer cares about. Bit N
+// of each mask is set when byte N of the block is of that class.
+typedef struct block_masks {
+    uint64_t structural; // ( ) , ;
+    uint64_t quote;
+    uint64_t double_quote;
+    uint64_t backtick;
+    uint64_t backslash;
+    uint64_t newline;
+    uint64_t asterisk;
+    uint64_t dash;
+    uint64_t slash;
+} block_masks_t;
+
+#if defined(SQLTOAST_HAVE_X86_SIMD)
+
+static inline uint64_t block_mask(const __m128i v[4], const char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    uint64_t mask = 0;
+    for (int x = 0; x < 4; x++) {
+        const uint32_t m = _mm_movemask_epi8(_mm_cmpeq_epi8(v[x], needle));
+        mask |= static_cast<uint64_t>(m) << (16 * x);
+    }
+    return mask;
+}
+
+static inline uint64_t structural_mask(const __m128i v[4]) {
+    uint64_t mask = 0;
+    for (int x = 0; x < 4; x++) {
+        const __m128i parens = _mm_or_si128(
+                _mm_cmpeq_epi8(v[x], _mm_set1_epi8('(')),
+                _mm_cmpeq_epi8(v[x], _mm_set1_epi8(')')));
+        const __m128i separators = _mm_or_si128(
+                _mm_cmpeq_epi8(v[x], _mm_set1_epi8(',')),
+                _mm_cmpeq_epi8(v[x], _mm_set1_epi8(';')));
+        const uint32_t m = _mm_movemask_epi8(_mm_or_si128(parens, separators));
+        mask |= static_cast<uint64_t>(m) << (16 * x);
+    }
+    return mask;
+}
+
+static void classify_block(const char* p, block_masks_t& m) {
+    __m128i v[4];
+    for (int x = 0; x < 4; x++)
+        v[x] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + (16 * x)));
+    m.structural = structural_mask(v);
+    m.quote = block_mask(v, '\'');
+    m.double_quote = block_mask(v, '"');
+    m.backtick = block_mask(v, '`');
+    m.backslash = block_mask(v, '\\');
+    m.newline = block_mask(v, '\n');
+    m.asterisk = block_mask(v, '*');
+    m.dash = block_mask(v, '-');
+    m.slash = block_mask(v, '/');
+}
+
+#else
+
+static void classify_block(const char* p, block_masks_t& m) {
+    m = block_masks_t{};
+    for (int x = 0; x < 64; x++) {
+        const uint64_t bit = 1ULL << x;
+        switch (p[x]) {
+            case '(':
+            case ')':
+            case ',':
+            case ';':
+                m.structural |= bit;
+                break;
+            case '\'':
+                m.quote |= bit;
+                break;
+            case '"':
+                m.double_quote |= bit;
+                break;
+            case '`':
+                m.backtick |= bit;
+                break;
+            case '\\':
+                m.backslash |= bit;
+                break;
+            case '\n':
+                m.newline |= bit;
+                break;
+            case '*':
+                m.asterisk |= bit;
+                break;
+            case '-':
+                m.dash |= bit;
+                break;
+            case '/':
+                m.slash |= bit;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+#endif // defined(SQLTOAST_HAVE_X86_SIMD)
+
+// Returns the bytes of a block that can change anything when the indexer is
+// in the supplied state. Inside a literal, for instance, only a quote or a
+// backslash can.
+static inline uint64_t relevant_bits(const block_masks_t& m, split_state_t state) {
+    switch (state) {
+        case SPLIT_STATE_NONE:
+            return m.structural | m.quote | m.double_quote | m.backtick |
+                m.dash | m.slash;
+        case SPLIT_STATE_QUOTE:
+            return m.quote | m.backslash;
+        case SPLIT_STATE_DOUBLE_QUOTE:
+            return m.double_quote;
+        case SPLIT_STATE_BACKTICK:
+            return m.backtick;
+        case SPLIT_STATE_LINE_COMMENT:
+            return m.newline;
+        case SPLIT_STATE_BLOCK_COMMENT:
+            return m.asterisk;
+    }
+    return 0;
+}
+
+// Returns a mask of the bits for the first n bytes of a block
+static inline uint64_t low_bits(size_t n) {
+    return n >= 64 ? ~0ULL : ((1ULL << n) - 1);
+}
+
+// Quotes, escapes and comments are recognized exactly as statement_splitter_t
+// recognizes them, so the index agrees with split_statements() about where
+// statements end.
+void structural_index::build(const char* start, const char* end) {
+    clear();
+    const size_t len = end - start;
+    if (len >= STRUCTURE_NO_MATCH)
+        return;
+    this->start = start;
+
+    // Indexes into offsets of the opening parentheses not yet matched
+    std::vector<uint32_t> open;
+    split_state_t state = SPLIT_STATE_NONE;
+    // Bytes before resume were consumed along with an earlier byte, as the
+    // second byte of a comment delimiter or an escaped character
+    const char* resume = start;
+    char tail[64];
+    for (const char* block = start; block < end; block += 64) {
+        const char* p = block;
+        if ((end - block) < 64) {
+            // The zeroes after the input match nothing
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, block, end - block);
+            p = tail;
+        }
+        block_masks_t m;
+        classify_block(p, m);
+        uint64_t done = 0;
+        if (resume > block)
+            done = low_bits(resume - block);
+        for (;;) {
+            const uint64_t bits = relevant_bits(m, state) & ~done;
+            if (bits == 0)
+                break;
+            const int bit = __builtin_ctzll(bits);
+            const char* cur = block + bit;
+            done |= low_bits(bit + 1);
+            switch (state) {
+                case SPLIT_STATE_NONE:
+                    switch (*cur) {
+                        case '(':
+                            open.push_back(offsets.size());
+                            offsets.push_back(cur - start);
+                            matches.push_back(STRUCTURE_NO_MATCH);
+                            break;
+                        case ')':
+                            if (open.empty()) {
+                                matches.push_back(STRUCTURE_NO_MATCH);
+                            } else {
+                                matches[open.back()] = offsets.size();
+                                matches.push_back(open.back());
+                                open.pop_back();
+                            }
+                            offsets.push_back(cur - start);
+                            break;
+                        case ',':
+                        case ';':
+                            offsets.push_back(cur - start);
+                            matches.push_back(open.empty() ?
+                                    STRUCTURE_NO_MATCH : open.back());
+                            break;
+                        case '\'':
+                            state = SPLIT_STATE_QUOTE;
+                            break;
+                        case '"':
+                            state = SPLIT_STATE_DOUBLE_QUOTE;
+                            break;
+                        case '`':
+                            state = SPLIT_STATE_BACKTICK;
+                            break;
+                        case '-':
+                            if ((cur + 1) != end && *(cur + 1) == '-') {
+                                state = SPLIT_STATE_LINE_COMMENT;
+                                resume = cur + 2;
+                                done |= low_bits(bit + 2);
+                            }
+                            break;
+                        case '/':
+                            if ((cur + 1) != end && *(cur + 1) == '*') {
+                                state = SPLIT_STATE_BLOCK_COMMENT;
+                                resume = cur + 2;
+                                done |= low_bits(bit + 2);
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                case SPLIT_STATE_QUOTE:
+                    if (*cur == '\\') {
+                        resume = cur + 2;
+                        done |= low_bits(bit + 2);
+                        break;
+                    }
+                    state = SPLIT_STATE_NONE;
+                    break;
+                case SPLIT_STATE_BLOCK_COMMENT:
+                    if ((cur + 1) != end && *(cur + 1) == '/') {
+                        state = SPLIT_STATE_NONE;
+                        resume = cur + 2;
+                        done |= low_bits(bit + 2);
+                    }
+                    break;
+                default:
+                    // The closing quote, backtick or newline
+                    state = SPLIT_STATE_NONE;
+                    break;
+            }
+        }
+    }
+}
+
+void structural_index::clear() {
+    offsets.clear();
+    matches.clear();
+    start = nullptr;
+}
+
+uint32_t structural_index::find(const char* pos) const {
+    if (start == nullptr || pos < start)
+        return STRUCTURE_NO_MATCH;
+    const size_t offset = pos - start;
+    auto it = std::lower_bound(offsets.cbegin(), offsets.cend(), offset);
+    if (it == offsets.cend() || *it != offset)
+        return STRUCTURE_NO_MATCH;
+    return it - offsets.cbegin();
+}
+
+const char* structural_index::matching_paren(const char* pos) const {
+    const uint32_t x = find(pos);
+    if (x == STRUCTURE_NO_MATCH || (*pos != '(' && *pos != ')'))
+        return nullptr;
+    const uint32_t match = matches[x];
+    if (match == STRUCTURE_NO_MATCH)
+        return nullptr;
+    return start + offsets[match];
+}
+
+} // namespace sqltoast
@@ -0,0 +1,60 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOAST_PARSER_STRUCTURE_H
+#define SQLTOAST_PARSER_STRUCTURE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace sqltoast {
+
+// Returned by structural_index_t::match() for a parenthesis with no partner
+const uint32_t STRUCTURE_NO_MATCH = UINT32_MAX;
+
+// An index of the structural characters in some input: the parentheses,
+// commas and semicolons that are not inside a string literal, delimited
+// identifier or comment. The index is built in a single pass over the input
+// that classifies 64 bytes at a time with SIMD compares, so that the bytes
+// inside literals, identifiers and comments are never looked at one by one
+// unless they are quotes, backslashes or comment delimiters.
+//
+// Once built, the parser can find the parenthesis matching any other in
+// constant time, given the parenthesis' place in the index, and can see
+// where a parenthesized expression ends before it parses the expression.
+typedef struct structural_index {
+    // Byte offsets from the start of the input of each structural character,
+    // in input order
+    std::vector<uint32_t> offsets;
+    // For each entry in offsets that is a parenthesis, the index in offsets
+    // of the matching parenthesis, or STRUCTURE_NO_MATCH if it has none. For
+    // commas and semicolons, the index of the innermost enclosing opening
+    // parenthesis, or STRUCTURE_NO_MATCH if there is none.
+    std::vector<uint32_t> matches;
+    // The input the index was built from
+    const char* start;
+    structural_index() :
+        start(nullptr)
+    {}
+    inline bool empty() const {
+        return start == nullptr;
+    }
+    // Indexes the structural characters in [start, end). Does nothing if the
+    // input is too large to be addressed by 32-bit offsets.
+    void build(const char* start, const char* end);
+    void clear();
+    // Returns the index in offsets of the structural character at the
+    // supplied position, or STRUCTURE_NO_MATCH if there is none there
+    uint32_t find(const char* pos) const;
+    // Returns the position of the parenthesis matching the one at the
+    // supplied position, or nullptr if either there is no parenthesis at the
+    // supplied position or it has no partner
+    const char* matching_paren(const char* pos) const;
+} structural_index_t;
+
+} // namespace sqltoast
+
+#endif /* SQLTOAST_PARSER_STRUCTURE_H */
@@ -8,200 +8,214 @@
 
 namespace sqltoast {
 
-symbol_map::symbol_map_t  _init_symbol_map() {
-    symbol_map::symbol_map_t m;
+typedef struct symbol_name_table {
+    const char* names[NUM_SYMBOLS];
+} symbol_name_table_t;
 
-    m[SYMBOL_SOS] = std::string("SOS");
-    m[SYMBOL_EOS] = std::string("EOS");
+// The symbol name table is built at compile time, so looking up a symbol's
+// name is a simple array index and nothing needs to be allocated or
+// initialized when the library is loaded. Symbols without a name (SYMBOL_NONE
+// and SYMBOL_ERROR) are printed as the empty string.
+constexpr symbol_name_table_t build_symbol_name_table() {
+    symbol_name_table_t t = {};
+    for (size_t x = 0; x < NUM_SYMBOLS; x++)
+        t.names[x] = "";
+
+    t.names[SYMBOL_SOS] = "SOS";
+    t.names[SYMBOL_EOS] = "EOS";
 
     // Punctuators
-    m[SYMBOL_ASTERISK] = std::string("'*'");
-    m[SYMBOL_COLON] = std::string("':'");
-    m[SYMBOL_CONCATENATION] = std::string("'||'");
-    m[SYMBOL_COMMA] = std::string("','");
-    m[SYMBOL_EXCLAMATION] = std::string("'!'");
-    m[SYMBOL_EQUAL] = std::string("'='");
-    m[SYMBOL_GREATER_THAN] = std::string("'>'");
-    m[SYMBOL_LESS_THAN] = std::string("'<'");
-    m[SYMBOL_LPAREN] = std::string("'('");
-    m[SYMBOL_MINUS] = std::string("'-'");
-    m[SYMBOL_NOT_EQUAL] = std::string("'<>'");
-    m[SYMBOL_PLUS] = std::string("'+'");
-    m[SYMBOL_QUESTION_MARK] = std::string("'?'");
-    m[SYMBOL_RPAREN] = std::string("')'");
-    m[SYMBOL_SEMICOLON] = std::string("';'");
-    m[SYMBOL_SOLIDUS] = std::string("'/'");
-    m[SYMBOL_VERTICAL_BAR] = std::string("'|'");
+    t.names[SYMBOL_ASTERISK] = "'*'";
+    t.names[SYMBOL_COLON] = "':'";
+    t.names[SYMBOL_CONCATENATION] = "'||'";
+    t.names[SYMBOL_COMMA] = "','";
+    t.names[SYMBOL_EXCLAMATION] = "'!'";
+    t.names[SYMBOL_EQUAL] = "'='";
+    t.names[SYMBOL_GREATER_THAN] = "'>'";
+    t.names[SYMBOL_LESS_THAN] = "'<'";
+    t.names[SYMBOL_LPAREN] = "'('";
+    t.names[SYMBOL_MINUS] = "'-'";
+    t.names[SYMBOL_NOT_EQUAL] = "'<>'";
+    t.names[SYMBOL_PLUS] = "'+'";
+    t.names[SYMBOL_QUESTION_MARK] = "'?'";
+    t.names[SYMBOL_RPAREN] = "')'";
+    t.names[SYMBOL_SEMICOLON] = "';'";
+    t.names[SYMBOL_SOLIDUS] = "'/'";
+    t.names[SYMBOL_VERTICAL_BAR] = "'|'";
 
     // Reserved keywords
-    m[SYMBOL_ACTION] = std::string("ACTION");
-    m[SYMBOL_ADD] = std::string("ADD");
-    m[SYMBOL_ALL] = std::string("ALL");
-    m[SYMBOL_ALTER] = std::string("ALTER");
-    m[SYMBOL_AND] = std::string("AND");
-    m[SYMBOL_ANY] = std::string("ANY");
-    m[SYMBOL_AS] = std::string("AS");
-    m[SYMBOL_AT] = std::string("AT");
-    m[SYMBOL_AUTHORIZATION] = std::string("AUTHORIZATION");
-    m[SYMBOL_AVG] = std::string("AVG");
-    m[SYMBOL_BETWEEN] = std::string("BETWEEN");
-    m[SYMBOL_BIT] = std::string("BIT");
-    m[SYMBOL_BIT_LENGTH] = std::string("BIT_LENGTH");
-    m[SYMBOL_BOTH] = std::string("BOTH");
-    m[SYMBOL_BY] = std::string("BY");
-    m[SYMBOL_CASCADE] = std::string("CASCADE");
-    m[SYMBOL_CASCADED] = std::string("CASCADED");
-    m[SYMBOL_CASE] = std::string("CASE");
-    m[SYMBOL_CHAR] = std::string("CHAR");
-    m[SYMBOL_CHARACTER] = std::string("CHARACTER");
-    m[SYMBOL_CHAR_LENGTH] = std::string("CHAR_LENGTH");
-    m[SYMBOL_CHARACTER_LENGTH] = std::string("CHARACTER_LENGTH");
-    m[SYMBOL_CHECK] = std::string("CHECK");
-    m[SYMBOL_COALESCE] = std::string("COALESCE");
-    m[SYMBOL_COLLATE] = std::string("COLLATE");
-    m[SYMBOL_COLLATION] = std::string("COLLATION");
-    m[SYMBOL_COLUMN] = std::string("COLUMN");
-    m[SYMBOL_COMMIT] = std::string("COMMIT");
-    m[SYMBOL_CONSTRAINT] = std::string("CONSTRAINT");
-    m[SYMBOL_CONVERT] = std::string("CONVERT");
-    m[SYMBOL_COUNT] = std::string("COUNT");
-    m[SYMBOL_CREATE] = std::string("CREATE");
-    m[SYMBOL_CROSS] = std::string("CROSS");
-    m[SYMBOL_CURRENT_DATE] = std::string("CURRENT_DATE");
-    m[SYMBOL_CURRENT_TIME] = std::string("CURRENT_TIME");
-    m[SYMBOL_CURRENT_TIMESTAMP] = std::string("CURRENT_TIMESTAMP");
-    m[SYMBOL_CURRENT_USER] = std::string("CURRENT_USER");
-    m[SYMBOL_DATE] = std::string("DATE");
-    m[SYMBOL_DAY] = std::string("DAY");
-    m[SYMBOL_DEC] = std::string("DEC");
-    m[SYMBOL_DECIMAL] = std::string("DECIMAL");
-    m[SYMBOL_DEFAULT] = std::string("DEFAULT");
-    m[SYMBOL_DELETE] = std::string("DELETE");
-    m[SYMBOL_DISTINCT] = std::string("DISTINCT");
-    m[SYMBOL_DROP] = std::string("DROP");
-    m[SYMBOL_DOMAIN] = std::string("DOMAIN");
-    m[SYMBOL_DOUBLE] = std::string("DOUBLE");
-    m[SYMBOL_END] = std::string("END");
-    m[SYMBOL_ESCAPE] = std::string("ESCAPE");
-    m[SYMBOL_ELSE] = std::string("ELSE");
-    m[SYMBOL_EXISTS] = std::string("EXISTS");
-    m[SYMBOL_EXTRACT] = std::string("EXTRACT");
-    m[SYMBOL_FLOAT] = std::string("FLOAT");
-    m[SYMBOL_FOR] = std::string("FOR");
-    m[SYMBOL_FOREIGN] = std::string("FOREIGN");
-    m[SYMBOL_FROM] = std::string("FROM");
-    m[SYMBOL_FULL] = std::string("FULL");
-    m[SYMBOL_GLOBAL] = std::string("GLOBAL");
-    m[SYMBOL_GRANT] = std::string("GRANT");
-    m[SYMBOL_GROUP] = std::string("GROUP");
-    m[SYMBOL_HAVING] = std::string("HAVING");
-    m[SYMBOL_HOUR] = std::string("HOUR");
-    m[SYMBOL_IN] = std::string("IN");
-    m[SYMBOL_INNER] = std::string("INNER");
-    m[SYMBOL_INSERT] = std::string("INSERT");
-    m[SYMBOL_INT] = std::string("INT");
-    m[SYMBOL_INTO] = std::string("INTO");
-    m[SYMBOL_INTEGER] = std::string("INTEGER");
-    m[SYMBOL_INTERVAL] = std::string("INTERVAL");
-    m[SYMBOL_IS] = std::string("IS");
-    m[SYMBOL_JOIN] = std::string("JOIN");
-    m[SYMBOL_LEADING] = std::string("LEADING");
-    m[SYMBOL_LEFT] = std::string("LEFT");
-    m[SYMBOL_LOCAL] = std::string("LOCAL");
-    m[SYMBOL_LIKE] = std::string("LIKE");
-    m[SYMBOL_KEY] = std::string("KEY");
-    m[SYMBOL_MATCH] = std::string("MATCH");
-    m[SYMBOL_MAX] = std::string("MAX");
-    m[SYMBOL_MIN] = std::string("MIN");
-    m[SYMBOL_MINUTE] = std::string("MINUTE");
-    m[SYMBOL_MONTH] = std::string("MONTH");
-    m[SYMBOL_NATIONAL] = std::string("NATIONAL");
-    m[SYMBOL_NATURAL] = std::string("NATURAL");
-    m[SYMBOL_NCHAR] = std::string("NCHAR");
-    m[SYMBOL_NO] = std::string("NO");
-    m[SYMBOL_NOT] = std::string("NOT");
-    m[SYMBOL_NUMERIC] = std::string("NUMERIC");
-    m[SYMBOL_NULL] = std::string("NULL");
-    m[SYMBOL_NULLIF] = std::string("NULLIF");
-    m[SYMBOL_OCTET_LENGTH] = std::string("OCTET_LENGTH");
-    m[SYMBOL_ON] = std::string("ON");
-    m[SYMBOL_OPTION] = std::string("OPTION");
-    m[SYMBOL_OR] = std::string("OR");
-    m[SYMBOL_OVERLAPS] = std::string("OVERLAPS");
-    m[SYMBOL_OUTER] = std::string("OUTER");
-    m[SYMBOL_PARTIAL] = std::string("PARTIAL");
-    m[SYMBOL_POSITION] = std::string("POSITION");
-    m[SYMBOL_PRECISION] = std::string("PRECISION");
-    m[SYMBOL_PRIMARY] = std::string("PRIMARY");
-    m[SYMBOL_PRIVILEGES] = std::string("PRIVILEGES");
-    m[SYMBOL_PUBLIC] = std::string("PUBLIC");
-    m[SYMBOL_REAL] = std::string("REAL");
-    m[SYMBOL_REFERENCES] = std::string("REFERENCES");
-    m[SYMBOL_RESTRICT] = std::string("RESTRICT");
-    m[SYMBOL_RIGHT] = std::string("RIGHT");
-    m[SYMBOL_ROLLBACK] = std::string("ROLLBACK");
-    m[SYMBOL_SCHEMA] = std::string("SCHEMA");
-    m[SYMBOL_SECOND] = std::string("SECOND");
-    m[SYMBOL_SELECT] = std::string("SELECT");
-    m[SYMBOL_SESSION_USER] = std::string("SESSION_USER");
-    m[SYMBOL_SET] = std::string("SET");
-    m[SYMBOL_SMALLINT] = std::string("SMALLINT");
-    m[SYMBOL_SOME] = std::string("SOME");
-    m[SYMBOL_SUBSTRING] = std::string("SUBSTRING");
-    m[SYMBOL_SUM] = std::string("SUM");
-    m[SYMBOL_SYSTEM_USER] = std::string("SYSTEM_USER");
-    m[SYMBOL_TABLE] = std::string("TABLE");
-    m[SYMBOL_TEMPORARY] = std::string("TEMPORARY");
-    m[SYMBOL_THEN] = std::string("THEN");
-    m[SYMBOL_TIME] = std::string("TIME");
-    m[SYMBOL_TIMESTAMP] = std::string("TIMESTAMP");
-    m[SYMBOL_TO] = std::string("TO");
-    m[SYMBOL_TRAILING] = std::string("TRAILING");
-    m[SYMBOL_TRANSLATE] = std::string("TRANSLATE");
-    m[SYMBOL_TRANSLATION] = std::string("TRANSLATION");
-    m[SYMBOL_TRIM] = std::string("TRIM");
-    m[SYMBOL_UNION] = std::string("UNION");
-    m[SYMBOL_UNIQUE] = std::string("UNIQUE");
-    m[SYMBOL_UPDATE] = std::string("UPDATE");
-    m[SYMBOL_UPPER] = std::string("UPPER");
-    m[SYMBOL_USAGE] = std::string("USAGE");
-    m[SYMBOL_USER] = std::string("USER");
-    m[SYMBOL_USING] = std::string("USING");
-    m[SYMBOL_VALUE] = std::string("VALUE");
-    m[SYMBOL_VALUES] = std::string("VALUES");
-    m[SYMBOL_VARCHAR] = std::string("VARCHAR");
-    m[SYMBOL_VARYING] = std::string("VARYING");
-    m[SYMBOL_VIEW] = std::string("VIEW");
-    m[SYMBOL_WHEN] = std::string("WHEN");
-    m[SYMBOL_WHERE] = std::string("WHERE");
-    m[SYMBOL_WITH] = std::string("WITH");
-    m[SYMBOL_WORK] = std::string("WORK");
-    m[SYMBOL_YEAR] = std::string("YEAR");
-    m[SYMBOL_ZONE] = std::string("ZONE");
+    t.names[SYMBOL_ACTION] = "ACTION";
+    t.names[SYMBOL_ADD] = "ADD";
+    t.names[SYMBOL_ALL] = "ALL";
+    t.names[SYMBOL_ALTER] = "ALTER";
+    t.names[SYMBOL_AND] = "AND";
+    t.names[SYMBOL_ANY] = "ANY";
+    t.names[SYMBOL_AS] = "AS";
+    t.names[SYMBOL_AT] = "AT";
+    t.names[SYMBOL_AUTHORIZATION] = "AUTHORIZATION";
+    t.names[SYMBOL_AVG] = "AVG";
+    t.names[SYMBOL_BETWEEN] = "BETWEEN";
+    t.names[SYMBOL_BIT] = "BIT";
+    t.names[SYMBOL_BIT_LENGTH] = "BIT_LENGTH";
+    t.names[SYMBOL_BOTH] = "BOTH";
+    t.names[SYMBOL_BY] = "BY";
+    t.names[SYMBOL_CASCADE] = "CASCADE";
+    t.names[SYMBOL_CASCADED] = "CASCADED";
+    t.names[SYMBOL_CASE] = "CASE";
+    t.names[SYMBOL_CHAR] = "CHAR";
+    t.names[SYMBOL_CHARACTER] = "CHARACTER";
+    t.names[SYMBOL_CHAR_LENGTH] = "CHAR_LENGTH";
+    t.names[SYMBOL_CHARACTER_LENGTH] = "CHARACTER_LENGTH";
+    t.names[SYMBOL_CHECK] = "CHECK";
+    t.names[SYMBOL_COALESCE] = "COALESCE";
+    t.names[SYMBOL_COLLATE] = "COLLATE";
+    t.names[SYMBOL_COLLATION] = "COLLATION";
+    t.names[SYMBOL_COLUMN] = "COLUMN";
+    t.names[SYMBOL_COMMIT] = "COMMIT";
+    t.names[SYMBOL_CONSTRAINT] = "CONSTRAINT";
+    t.names[SYMBOL_CONVERT] = "CONVERT";
+    t.names[SYMBOL_COUNT] = "COUNT";
+    t.names[SYMBOL_CREATE] = "CREATE";
+    t.names[SYMBOL_CROSS] = "CROSS";
+    t.names[SYMBOL_CURRENT_DATE] = "CURRENT_DATE";
+    t.names[SYMBOL_CURRENT_TIME] = "CURRENT_TIME";
+    t.names[SYMBOL_CURRENT_TIMESTAMP] = "CURRENT_TIMESTAMP";
+    t.names[SYMBOL_CURRENT_USER] = "CURRENT_USER";
+    t.names[SYMBOL_DATE] = "DATE";
+    t.names[SYMBOL_DAY] = "DAY";
+    t.names[SYMBOL_DEC] = "DEC";
+    t.names[SYMBOL_DECIMAL] = "DECIMAL";
+    t.names[SYMBOL_DEFAULT] = "DEFAULT";
+    t.names[SYMBOL_DELETE] = "DELETE";
+    t.names[SYMBOL_DISTINCT] = "DISTINCT";
+    t.names[SYMBOL_DROP] = "DROP";
+    t.names[SYMBOL_DOMAIN] = "DOMAIN";
+    t.names[SYMBOL_DOUBLE] = "DOUBLE";
+    t.names[SYMBOL_END] = "END";
+    t.names[SYMBOL_ESCAPE] = "ESCAPE";
+    t.names[SYMBOL_ELSE] = "ELSE";
+    t.names[SYMBOL_EXISTS] = "EXISTS";
+    t.names[SYMBOL_EXTRACT] = "EXTRACT";
+    t.names[SYMBOL_FLOAT] = "FLOAT";
+    t.names[SYMBOL_FOR] = "FOR";
+    t.names[SYMBOL_FOREIGN] = "FOREIGN";
+    t.names[SYMBOL_FROM] = "FROM";
+    t.names[SYMBOL_FULL] = "FULL";
+    t.names[SYMBOL_GLOBAL] = "GLOBAL";
+    t.names[SYMBOL_GRANT] = "GRANT";
+    t.names[SYMBOL_GROUP] = "GROUP";
+    t.names[SYMBOL_HAVING] = "HAVING";
+    t.names[SYMBOL_HOUR] = "HOUR";
+    t.names[SYMBOL_IN] = "IN";
+    t.names[SYMBOL_INNER] = "INNER";
+    t.names[SYMBOL_INSERT] = "INSERT";
+    t.names[SYMBOL_INT] = "INT";
+    t.names[SYMBOL_INTO] = "INTO";
+    t.names[SYMBOL_INTEGER] = "INTEGER";
+    t.names[SYMBOL_INTERVAL] = "INTERVAL";
+    t.names[SYMBOL_IS] = "IS";
+    t.names[SYMBOL_JOIN] = "JOIN";
+    t.names[SYMBOL_LEADING] = "LEADING";
+    t.names[SYMBOL_LEFT] = "LEFT";
+    t.names[SYMBOL_LOCAL] = "LOCAL";
+    t.names[SYMBOL_LIKE] = "LIKE";
+    t.names[SYMBOL_KEY] = "KEY";
+    t.names[SYMBOL_MATCH] = "MATCH";
+    t.names[SYMBOL_MAX] = "MAX";
+    t.names[SYMBOL_MIN] = "MIN";
+    t.names[SYMBOL_MINUTE] = "MINUTE";
+    t.names[SYMBOL_MONTH] = "MONTH";
+    t.names[SYMBOL_NATIONAL] = "NATIONAL";
+    t.names[SYMBOL_NATURAL] = "NATURAL";
+    t.names[SYMBOL_NCHAR] = "NCHAR";
+    t.names[SYMBOL_NO] = "NO";
+    t.names[SYMBOL_NOT] = "NOT";
+    t.names[SYMBOL_NUMERIC] = "NUMERIC";
+    t.names[SYMBOL_NULL] = "NULL";
+    t.names[SYMBOL_NULLIF] = "NULLIF";
+    t.names[SYMBOL_OCTET_LENGTH] = "OCTET_LENGTH";
+    t.names[SYMBOL_ON] = "ON";
+    t.names[SYMBOL_OPTION] = "OPTION";
+    t.names[SYMBOL_OR] = "OR";
+    t.names[SYMBOL_OVERLAPS] = "OVERLAPS";
+    t.names[SYMBOL_OUTER] = "OUTER";
+    t.names[SYMBOL_PARTIAL] = "PARTIAL";
+    t.names[SYMBOL_POSITION] = "POSITION";
+    t.names[SYMBOL_PRECISION] = "PRECISION";
+    t.names[SYMBOL_PRIMARY] = "PRIMARY";
+    t.names[SYMBOL_PRIVILEGES] = "PRIVILEGES";
+    t.names[SYMBOL_PUBLIC] = "PUBLIC";
+    t.names[SYMBOL_REAL] = "REAL";
+    t.names[SYMBOL_REFERENCES] = "REFERENCES";
+    t.names[SYMBOL_RESTRICT] = "RESTRICT";
+    t.names[SYMBOL_RIGHT] = "RIGHT";
+    t.names[SYMBOL_ROLLBACK] = "ROLLBACK";
+    t.names[SYMBOL_SCHEMA] = "SCHEMA";
+    t.names[SYMBOL_SECOND] = "SECOND";
+    t.names[SYMBOL_SELECT] = "SELECT";
+    t.names[SYMBOL_SESSION_USER] = "SESSION_USER";
+    t.names[SYMBOL_SET] = "SET";
+    t.names[SYMBOL_SMALLINT] = "SMALLINT";
+    t.names[SYMBOL_SOME] = "SOME";
+    t.names[SYMBOL_SUBSTRING] = "SUBSTRING";
+    t.names[SYMBOL_SUM] = "SUM";
+    t.names[SYMBOL_SYSTEM_USER] = "SYSTEM_USER";
+    t.names[SYMBOL_TABLE] = "TABLE";
+    t.names[SYMBOL_TEMPORARY] = "TEMPORARY";
+    t.names[SYMBOL_THEN] = "THEN";
+    t.names[SYMBOL_TIME] = "TIME";
+    t.names[SYMBOL_TIMESTAMP] = "TIMESTAMP";
+    t.names[SYMBOL_TO] = "TO";
+    t.names[SYMBOL_TRAILING] = "TRAILING";
+    t.names[SYMBOL_TRANSLATE] = "TRANSLATE";
+    t.names[SYMBOL_TRANSLATION] = "TRANSLATION";
+    t.names[SYMBOL_TRIM] = "TRIM";
+    t.names[SYMBOL_UNION] = "UNION";
+    t.names[SYMBOL_UNIQUE] = "UNIQUE";
+    t.names[SYMBOL_UPDATE] = "UPDATE";
+    t.names[SYMBOL_UPPER] = "UPPER";
+    t.names[SYMBOL_USAGE] = "USAGE";
+    t.names[SYMBOL_USER] = "USER";
+    t.names[SYMBOL_USING] = "USING";
+    t.names[SYMBOL_VALUE] = "VALUE";
+    t.names[SYMBOL_VALUES] = "VALUES";
+    t.names[SYMBOL_VARCHAR] = "VARCHAR";
+    t.names[SYMBOL_VARYING] = "VARYING";
+    t.names[SYMBOL_VIEW] = "VIEW";
+    t.names[SYMBOL_WHEN] = "WHEN";
+    t.names[SYMBOL_WHERE] = "WHERE";
+    t.names[SYMBOL_WITH] = "WITH";
+    t.names[SYMBOL_WORK] = "WORK";
+    t.names[SYMBOL_YEAR] = "YEAR";
+    t.names[SYMBOL_ZONE] = "ZONE";
 
-    // Non-Reserved keywordsr
+    // Non-Reserved keywords
 
     // Other symbols
-    m[SYMBOL_COMMENT] = std::string("<< comment >>");
-    m[SYMBOL_IDENTIFIER] = std::string("<< identifier >>");
+    t.names[SYMBOL_COMMENT] = "<< comment >>";
+    t.names[SYMBOL_IDENTIFIER] = "<< identifier >>";
 
-    m[SYMBOL_LITERAL_APPROXIMATE_NUMBER] = std::string("<< approximate number >>");
-    m[SYMBOL_LITERAL_BIT_STRING] = std::string("<< bit string literal >>");
-    m[SYMBOL_LITERAL_CHARACTER_STRING] = std::string("<< string literal >>");
-    m[SYMBOL_LITERAL_HEX_STRING] = std::string("<< hex string literal >>");
-    m[SYMBOL_LITERAL_NATIONAL_CHARACTER_STRING] = std::string("<< utf8 string literal >>");
-    m[SYMBOL_LITERAL_SIGNED_DECIMAL] = std::string("<< signed decimal >>");
-    m[SYMBOL_LITERAL_SIGNED_INTEGER] = std::string("<< signed integer >>");
-    m[SYMBOL_LITERAL_UNSIGNED_DECIMAL] = std::string("<< unsigned decimal >>");
-    m[SYMBOL_LITERAL_UNSIGNED_INTEGER] = std::string("<< unsigned integer >>");
+    t.names[SYMBOL_LITERAL_APPROXIMATE_NUMBER] = "<< approximate number >>";
+    t.names[SYMBOL_LITERAL_BIT_STRING] = "<< bit string literal >>";
+    t.names[SYMBOL_LITERAL_CHARACTER_STRING] = "<< string literal >>";
+    t.names[SYMBOL_LITERAL_HEX_STRING] = "<< hex string literal >>";
+    t.names[SYMBOL_LITERAL_NATIONAL_CHARACTER_STRING] = "<< utf8 string literal >>";
+    t.names[SYMBOL_LITERAL_SIGNED_DECIMAL] = "<< signed decimal >>";
+    t.names[SYMBOL_LITERAL_SIGNED_INTEGER] = "<< signed integer >>";
+    t.names[SYMBOL_LITERAL_UNSIGNED_DECIMAL] = "<< unsigned decimal >>";
+    t.names[SYMBOL_LITERAL_UNSIGNED_INTEGER] = "<< unsigned integer >>";
 
-    return m;
+    return t;
 }
 
-symbol_map::symbol_map_t symbol_map::m = _init_symbol_map();
+constexpr symbol_name_table_t symbol_names = build_symbol_name_table();
+
+const char* symbol_name(const symbol_t sym) {
+    return symbol_names.names[sym];
+}
 
 std::ostream& operator<< (std::ostream& out, const symbol_t& sym) {
-    out << symbol_map::m[sym];
+    out << symbol_name(sym);
     return out;
 }
 
@@ -151,13 +151,8 @@ err_expect_join:
     expect_error(ctx, SYMBOL_JOIN);
     return false;
 err_expect_table_reference:
-    {
-        std::stringstream estr;
-        estr << "Expected <table reference> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <table reference>");
+    return false;
 optional_join_specification:
     // We get here after successfully parsing an INNER or OUTER symbol followed
     // by a JOIN symbol. We now must check for the optional <join
@@ -182,13 +177,8 @@ process_join_condition:
         goto err_expect_join_condition;
     goto push_join;
 err_expect_join_condition:
-    {
-        std::stringstream estr;
-        estr << "Expected <join condition> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <join condition>");
+    return false;
 process_named_columns:
     // We get here after parsing a USING symbol, which must be followed by a
     // parens-enclosed list of column identifiers
@@ -297,13 +287,8 @@ err_expect_identifier:
     expect_error(ctx, SYMBOL_IDENTIFIER);
     return false;
 err_expect_query_expression:
-{
-    std::stringstream estr;
-    estr << "Expected <query expression> but found "
-         << cur_tok << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    expect_construct_error(ctx, "Expected <query expression>");
     return false;
-}
 push_derived_table:
     if (ctx.opts.disable_statement_construction)
         return true;
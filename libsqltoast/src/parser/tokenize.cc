@@ -0,0 +1,55 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include "sqltoast/sqltoast.h"
+
+#include "parser/lexer.h"
+#include "parser/token.h"
+
+namespace sqltoast {
+
+token_iterator::token_iterator(parse_position_t start, parse_position_t end) :
+    cursor(start),
+    end(end),
+    token(SYMBOL_SOS, start, start)
+{
+    ++(*this);
+}
+
+token_iterator& token_iterator::operator++() {
+    if (token.symbol == SYMBOL_EOS)
+        return *this;
+    parse_position_t cur = skip(cursor, end);
+    if (cur >= end) {
+        token = token_t(SYMBOL_EOS, end, end);
+        cursor = end;
+        return *this;
+    }
+
+    auto tok_res = tokenize_at(cur, end);
+    if (tok_res.code == TOKEN_NOT_FOUND) {
+        // Unlike the parser, which stops at the first byte that cannot start
+        // a token, we report the byte and carry on with the next one
+        token = token_t(SYMBOL_ERROR, cur, cur + 1);
+        cursor = cur + 1;
+        return *this;
+    }
+    // If there was an error in finding the token, then tok_res.token will
+    // contain SYMBOL_ERROR and the lexeme will span the bytes in error
+    token = tok_res.token;
+    cursor = token.lexeme.end;
+    return *this;
+}
+
+token_range_t tokenize(parse_input_t& subject) {
+    return tokenize(subject.data(), subject.size());
+}
+
+token_range_t tokenize(const char* subject, size_t len) {
+    return token_range_t(subject, subject + len);
+}
+
+} // namespace sqltoast
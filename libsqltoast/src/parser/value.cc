@@ -68,13 +68,9 @@ optional_operator:
     }
     return true;
 err_expect_numeric_factor:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric factor> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <numeric factor> after finding numeric operator");
+    return false;
 ensure_term:
     if (ctx.opts.disable_statement_construction)
         goto optional_operator;
@@ -260,11 +256,13 @@ bool parse_unsigned_value_specification(
         std::unique_ptr<value_expression_primary_t>& out) {
     lexer_t& lex = ctx.lexer;
     lexeme_t uvs_lexeme;
+    literal_value_t uvs_value;
     uvs_type_t uvs_type;
     symbol_t cur_sym = cur_tok.symbol;
     if (cur_tok.is_literal()) {
         uvs_type = UVS_TYPE_UNSIGNED_NUMERIC;
         uvs_lexeme = cur_tok.lexeme;
+        uvs_value = cur_tok.value;
         cur_tok = lex.next();
         goto push_spec;
     }
@@ -350,7 +348,8 @@ err_expect_identifier:
 push_spec:
     if (ctx.opts.disable_statement_construction)
         return true;
-    out = std::make_unique<unsigned_value_specification_t>(uvs_type, uvs_lexeme);
+    out = std::make_unique<unsigned_value_specification_t>(uvs_type,
+            uvs_lexeme, uvs_value);
     return true;
 }
 
@@ -528,13 +527,8 @@ process_coalesce_argument:
     cur_tok = lex.next();
     goto push_coalesce;
 err_expect_value_expression:
-    {
-        std::stringstream estr;
-        estr << "expected <value expression> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "expected <value expression>");
+    return false;
 err_expect_rparen:
     expect_error(ctx, SYMBOL_RPAREN);
     return false;
@@ -859,13 +853,8 @@ err_expect_lparen:
     expect_error(ctx, SYMBOL_LPAREN);
     return false;
 err_expect_character_value_expression:
-{
-    std::stringstream estr;
-    estr << "Expected <character value expression> but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    expect_construct_error(ctx, "Expected <character value expression>");
     return false;
-}
 err_expect_in:
     expect_error(ctx, SYMBOL_IN);
     return false;
@@ -924,22 +913,13 @@ err_expect_from:
     expect_error(ctx, SYMBOL_FROM);
     return false;
 err_expect_extract_field:
-{
-    std::stringstream estr;
-    estr << "Expected <extract field> but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    expect_construct_error(ctx, "Expected <extract field>");
     return false;
-}
 err_expect_extract_source:
-{
-    std::stringstream estr;
-    estr << "Expected <extract source> which can be a datetime or "
-            "interval value expression but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    expect_construct_error(ctx,
+            "Expected <extract source> which can be a datetime or interval "
+            "value expression");
     return false;
-}
 process_length_expression:
     // We get here after getting a one of the CHAR_LENGTH, BIT_LENGTH or
     // OCTET_LENGTH symbols. We now need to process the required string
@@ -956,13 +936,8 @@ process_length_expression:
     cur_tok = lex.next();
     goto push_length_expression;
 err_expect_string_value_expression:
-{
-    std::stringstream estr;
-    estr << "Expected <string value expression> but found " << cur_tok
-         << std::endl;
-    create_syntax_error_marker(ctx, estr);
+    expect_construct_error(ctx, "Expected <string value expression>");
     return false;
-}
 push_position_expression:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -1102,13 +1077,9 @@ process_operand:
     }
     goto expect_rparen;
 err_expect_operand:
-    {
-        std::stringstream estr;
-        estr << "Expected <character value expression> as operand but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <character value expression> as operand");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -1170,13 +1141,9 @@ err_expect_from:
     expect_error(ctx, SYMBOL_FROM);
     return false;
 err_expect_start_position:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric value expression> after FROM but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <numeric value expression> after FROM");
+    return false;
 optional_for_length:
     cur_sym = cur_tok.symbol;
     if (cur_sym == SYMBOL_FOR) {
@@ -1189,13 +1156,9 @@ optional_for_length:
     }
     goto expect_rparen;
 err_expect_numeric_for_length:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric value expression> after FOR but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <numeric value expression> after FOR");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -1400,14 +1363,10 @@ expect_trim_character:
     cur_tok = lex.next();
     goto process_operand;
 err_expect_trim_character:
-    {
-        std::stringstream estr;
-        estr << "Expected <character value expression> after "
-                "<trim specification> but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <character value expression> after <trim "
+            "specification>");
+    return false;
 err_expect_from:
     expect_error(ctx, SYMBOL_FROM);
     return false;
@@ -1419,14 +1378,10 @@ process_operand:
     }
     goto expect_rparen;
 err_expect_operand:
-    {
-        std::stringstream estr;
-        estr << "Expected <character value expression> as operand for TRIM "
-                "function but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <character value expression> as operand for TRIM "
+            "function");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -1516,13 +1471,9 @@ expect_tz_name:
     cur_tok = lex.next();
     goto push_factor;
 err_expect_tz_name:
-    {
-        std::stringstream estr;
-        estr << "Expected <time zone name> after AT TIME ZONE but found "
-             << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <time zone name> after AT TIME ZONE");
+    return false;
 push_factor:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -1652,13 +1603,9 @@ optional_operator:
     }
     return true;
 err_expect_numeric_factor:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric factor> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <numeric factor> after finding numeric operator");
+    return false;
 ensure_term:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -20,8 +20,7 @@ bool parse_row_value_constructor(
         token_t& cur_tok,
         std::unique_ptr<row_value_constructor_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = lex.cursor;
-    token_t start_tok = lex.current_token;
+    lexer_checkpoint_t start = lex.checkpoint();
     symbol_t cur_sym = cur_tok.symbol;
     std::unique_ptr<row_value_constructor_t> element;
     std::vector<std::unique_ptr<row_value_constructor_t>> elements;
@@ -31,8 +30,7 @@ bool parse_row_value_constructor(
     // Reset cursor to before parsing of element attempt. Remember that a row
     // value constructor element can also start with a LPAREN, which is why we
     // do this.
-    lex.cursor = start;
-    lex.current_token = cur_tok = start_tok;
+    lex.rewind(start);
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_LPAREN)
         return false;
@@ -53,13 +51,8 @@ process_rvc_list_element:
     }
     goto expect_rparen;
 err_expect_row_value_constructor_element:
-    {
-        std::stringstream estr;
-        estr << "Expected <row value constructor element> "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx, "Expected <row value constructor element>");
+    return false;
 expect_rparen:
     cur_sym = cur_tok.symbol;
     if (cur_sym != SYMBOL_RPAREN)
@@ -117,29 +110,25 @@ bool parse_value_expression(
         token_t& cur_tok,
         std::unique_ptr<value_expression_t>& out) {
     lexer_t& lex = ctx.lexer;
-    parse_position_t start = lex.cursor;
-    token_t start_tok = cur_tok;
+    lexer_checkpoint_t start = lex.checkpoint();
     if (parse_numeric_value_expression(ctx, cur_tok, out))
         return true;
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     // Reset our cursor
-    lex.cursor = start;
-    cur_tok = start_tok;
+    lex.rewind(start);
     if (parse_string_value_expression(ctx, cur_tok, out))
         return true;
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     // Reset our cursor
-    lex.cursor = start;
-    cur_tok = start_tok;
+    lex.rewind(start);
     if (parse_datetime_value_expression(ctx, cur_tok, out))
         return true;
     if (ctx.result.code == PARSE_SYNTAX_ERROR)
         return false;
     // Reset our cursor
-    lex.cursor = start;
-    cur_tok = start_tok;
+    lex.rewind(start);
     return parse_interval_value_expression(ctx, cur_tok, out);
 }
 
@@ -192,13 +181,9 @@ optional_operator:
     }
     return false;
 err_expect_numeric_term:
-    {
-        std::stringstream estr;
-        estr << "Expected <numeric term> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <numeric term> after finding numeric operator");
+    return false;
 ensure_expression:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -258,13 +243,9 @@ optional_concat:
     }
     return false;
 err_expect_char_factor:
-    {
-        std::stringstream estr;
-        estr << "Expected <character factor> after concatenation "
-                "operator but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <character factor> after concatenation operator");
+    return false;
 push_ve:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -325,13 +306,9 @@ optional_operator:
     }
     return false;
 err_expect_interval_term:
-    {
-        std::stringstream estr;
-        estr << "Expected <interval term> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <interval term> after finding numeric operator");
+    return false;
 ensure_expression:
     if (ctx.opts.disable_statement_construction)
         return true;
@@ -393,13 +370,9 @@ optional_operator:
     }
     return false;
 err_expect_interval_term:
-    {
-        std::stringstream estr;
-        estr << "Expected <interval term> after finding numeric operator "
-                "but found " << cur_tok << std::endl;
-        create_syntax_error_marker(ctx, estr);
-        return false;
-    }
+    expect_construct_error(ctx,
+            "Expected <interval term> after finding numeric operator");
+    return false;
 ensure_expression:
     if (ctx.opts.disable_statement_construction)
         return true;
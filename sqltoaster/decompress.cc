@@ -0,0 +1,364 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef SQLTOASTER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef SQLTOASTER_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "decompress.h"
+
+namespace sqltoaster {
+
+// Reads up to len bytes from fd, retrying when interrupted. Returns the number
+// of bytes read, which is 0 at the end of the input, or -1 on error.
+static ssize_t read_raw(int fd, char* buf, size_t len) {
+    for (;;) {
+        ssize_t n = ::read(fd, buf, len);
+        if (n >= 0 || errno != EINTR)
+            return n;
+    }
+}
+
+static input_format_t detect_format(const char* first, size_t len) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(first);
+    if (len >= 2 && p[0] == 0x1f && p[1] == 0x8b)
+        return INPUT_FORMAT_GZIP;
+    if (len >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f &&
+            p[3] == 0xfd)
+        return INPUT_FORMAT_ZSTD;
+    return INPUT_FORMAT_PLAIN;
+}
+
+decompressor::decompressor(int fd, size_t buffer_size, size_t ring_size) :
+    fd(fd),
+    buffer_size(buffer_size),
+    format(INPUT_FORMAT_PLAIN),
+    ring(ring_size < 2 ? 2 : ring_size, std::vector<char>(buffer_size)),
+    lens(ring.size()),
+    produced(0),
+    consumed(0),
+    pos(0),
+    done(false),
+    failed(false),
+    stopped(false)
+{
+    thread = std::thread(&decompressor::run, this);
+}
+
+decompressor::~decompressor() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopped = true;
+    }
+    cv_free.notify_one();
+    thread.join();
+}
+
+bool decompressor::read(char* buf, size_t len, size_t* nread) {
+    *nread = 0;
+    if (pos == 0) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_full.wait(lock, [this] { return produced > consumed || done; });
+        if (produced == consumed) {
+            if (failed)
+                return false;
+            return true;
+        }
+    }
+    const size_t x = consumed % ring.size();
+    size_t n = lens[x] - pos;
+    if (n > len)
+        n = len;
+    memcpy(buf, ring[x].data() + pos, n);
+    pos += n;
+    *nread = n;
+    if (pos == lens[x]) {
+        pos = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            consumed++;
+        }
+        cv_free.notify_one();
+    }
+    return true;
+}
+
+char* decompressor::acquire() {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv_free.wait(lock, [this] {
+        return stopped || (produced - consumed) < ring.size();
+    });
+    if (stopped)
+        return nullptr;
+    return ring[produced % ring.size()].data();
+}
+
+void decompressor::publish(size_t len) {
+    if (len == 0)
+        return;
+    lens[produced % ring.size()] = len;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        produced++;
+    }
+    cv_full.notify_one();
+}
+
+void decompressor::finish(const std::string& err) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        // error is only read by read() once it sees done, so it is written
+        // under the lock along with it
+        if (! err.empty()) {
+            error = err;
+            failed = true;
+        }
+        done = true;
+    }
+    cv_full.notify_one();
+}
+
+void decompressor::run() {
+    // Read enough of the input to recognize the format by its magic number
+    std::vector<char> first(buffer_size);
+    size_t first_len = 0;
+    while (first_len < 4) {
+        ssize_t n = read_raw(fd, first.data() + first_len,
+                first.size() - first_len);
+        if (n == -1) {
+            finish(std::string("Failed to read input: ") + strerror(errno));
+            return;
+        }
+        if (n == 0)
+            break;
+        first_len += n;
+    }
+    format = detect_format(first.data(), first_len);
+    std::string err;
+    switch (format) {
+        case INPUT_FORMAT_GZIP:
+            inflate_gzip(first.data(), first_len, err);
+            break;
+        case INPUT_FORMAT_ZSTD:
+            decompress_zstd(first.data(), first_len, err);
+            break;
+        default:
+            copy_plain(first.data(), first_len, err);
+            break;
+    }
+    finish(err);
+}
+
+bool decompressor::copy_plain(
+        const char* first,
+        size_t first_len,
+        std::string& err) {
+    char* out = acquire();
+    if (out == nullptr)
+        return false;
+    memcpy(out, first, first_len);
+    size_t filled = first_len;
+    for (;;) {
+        if (filled == buffer_size) {
+            publish(filled);
+            if ((out = acquire()) == nullptr)
+                return false;
+            filled = 0;
+        }
+        ssize_t n = read_raw(fd, out + filled, buffer_size - filled);
+        if (n == -1) {
+            // Whatever was read before the error can still be parsed
+            publish(filled);
+            err.assign("Failed to read input: ").append(strerror(errno));
+            return false;
+        }
+        if (n == 0)
+            break;
+        filled += n;
+    }
+    publish(filled);
+    return true;
+}
+
+#ifdef SQLTOASTER_HAVE_ZLIB
+bool decompressor::inflate_gzip(
+        const char* first,
+        size_t first_len,
+        std::string& err) {
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    // 15 + 32 has zlib expect a gzip (or zlib) header
+    if (inflateInit2(&zs, 15 + 32) != Z_OK) {
+        err.assign("Failed to initialize zlib.");
+        return false;
+    }
+    std::vector<char> in(first, first + first_len);
+    in.resize(buffer_size);
+    zs.next_in = reinterpret_cast<Bytef*>(in.data());
+    zs.avail_in = first_len;
+    char* out = acquire();
+    bool ok = (out != nullptr);
+    // True when the last gzip member seen was complete. A file may hold
+    // several members one after another, as produced by concatenating files.
+    bool member_ended = false;
+    bool eof = false;
+    zs.next_out = reinterpret_cast<Bytef*>(out);
+    zs.avail_out = buffer_size;
+    while (ok) {
+        if (zs.avail_in == 0 && ! eof) {
+            ssize_t n = read_raw(fd, in.data(), in.size());
+            if (n == -1) {
+                err.assign("Failed to read input: ").append(strerror(errno));
+                ok = false;
+                break;
+            }
+            eof = (n == 0);
+            zs.next_in = reinterpret_cast<Bytef*>(in.data());
+            zs.avail_in = n;
+        }
+        if (member_ended) {
+            if (zs.avail_in == 0)
+                break;
+            inflateReset(&zs);
+            member_ended = false;
+        }
+        int rc = inflate(&zs, Z_NO_FLUSH);
+        if (rc == Z_STREAM_END)
+            member_ended = true;
+        else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            err.assign("Failed to decompress gzip input: ").append(
+                    zs.msg != nullptr ? zs.msg : "invalid data");
+            ok = false;
+            break;
+        }
+        if (zs.avail_out == 0) {
+            publish(buffer_size);
+            if ((out = acquire()) == nullptr) {
+                ok = false;
+                break;
+            }
+            zs.next_out = reinterpret_cast<Bytef*>(out);
+            zs.avail_out = buffer_size;
+        } else if (eof && ! member_ended) {
+            // Everything that can be inflated without more input has been
+            break;
+        }
+    }
+    // Whatever was inflated before an error can still be parsed, so it is
+    // published either way. out is nullptr only if the decompressor is being
+    // destroyed.
+    if (out != nullptr)
+        publish(buffer_size - zs.avail_out);
+    if (ok) {
+        if (! member_ended) {
+            err.assign("Failed to decompress gzip input: unexpected end of "
+                    "input.");
+            ok = false;
+        }
+    }
+    inflateEnd(&zs);
+    return ok;
+}
+#else
+bool decompressor::inflate_gzip(
+        const char*,
+        size_t,
+        std::string& err) {
+    err.assign("Input is gzip-compressed, but sqltoaster was built without "
+            "zlib.");
+    return false;
+}
+#endif
+
+#ifdef SQLTOASTER_HAVE_ZSTD
+bool decompressor::decompress_zstd(
+        const char* first,
+        size_t first_len,
+        std::string& err) {
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (dctx == nullptr) {
+        err.assign("Failed to initialize zstd.");
+        return false;
+    }
+    std::vector<char> in_buf(first, first + first_len);
+    in_buf.resize(buffer_size);
+    ZSTD_inBuffer in = {in_buf.data(), first_len, 0};
+    char* out_buf = acquire();
+    bool ok = (out_buf != nullptr);
+    ZSTD_outBuffer out = {out_buf, buffer_size, 0};
+    // 0 once the last frame seen was complete. Frames simply follow one
+    // another, as produced by concatenating files.
+    size_t rc = 0;
+    bool eof = false;
+    while (ok) {
+        if (in.pos == in.size && ! eof) {
+            ssize_t n = read_raw(fd, in_buf.data(), in_buf.size());
+            if (n == -1) {
+                err.assign("Failed to read input: ").append(strerror(errno));
+                ok = false;
+                break;
+            }
+            eof = (n == 0);
+            in.size = n;
+            in.pos = 0;
+        }
+        if (eof && rc == 0)
+            break;
+        rc = ZSTD_decompressStream(dctx, &out, &in);
+        if (ZSTD_isError(rc)) {
+            err.assign("Failed to decompress zstd input: ").append(
+                    ZSTD_getErrorName(rc));
+            ok = false;
+            break;
+        }
+        if (out.pos == out.size) {
+            publish(out.pos);
+            if ((out_buf = acquire()) == nullptr) {
+                ok = false;
+                break;
+            }
+            out.dst = out_buf;
+            out.pos = 0;
+        } else if (eof) {
+            // zstd flushes all it can whenever it leaves room in the output,
+            // so without more input there is nothing left to decompress
+            break;
+        }
+    }
+    // Whatever was decompressed before an error can still be parsed, so it
+    // is published either way. out_buf is nullptr only if the decompressor is
+    // being destroyed.
+    if (out_buf != nullptr)
+        publish(out.pos);
+    if (ok) {
+        if (rc != 0) {
+            err.assign("Failed to decompress zstd input: unexpected end of "
+                    "input.");
+            ok = false;
+        }
+    }
+    ZSTD_freeDCtx(dctx);
+    return ok;
+}
+#else
+bool decompressor::decompress_zstd(
+        const char*,
+        size_t,
+        std::string& err) {
+    err.assign("Input is zstd-compressed, but sqltoaster was built without "
+            "libzstd.");
+    return false;
+}
+#endif
+
+} // namespace sqltoaster
@@ -0,0 +1,84 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOASTER_DECOMPRESS_H
+#define SQLTOASTER_DECOMPRESS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sqltoaster {
+
+// The formats a decompressor can find its input to be in
+typedef enum input_format {
+    INPUT_FORMAT_PLAIN,
+    INPUT_FORMAT_GZIP,
+    INPUT_FORMAT_ZSTD
+} input_format_t;
+
+// The default number of buffers in a decompressor's ring
+const size_t DECOMPRESS_RING_SIZE = 4;
+
+// Reads a file descriptor on a thread of its own, decompressing gzip and zstd
+// input (when sqltoaster is built with zlib and libzstd) into a ring of
+// buffers that read() drains on the parsing thread. The format is found from
+// the first bytes of the input, so standard input works too, and input that
+// isn't compressed is passed through untouched. Decompressing the next
+// buffers while the parser works through the previous ones means that
+// parsing a compressed dump takes little longer than decompressing it.
+typedef struct decompressor {
+    int fd;
+    size_t buffer_size;
+    input_format_t format;
+    // Set when read() returns false
+    std::string error;
+    // The ring of buffers. The decompressing thread fills the buffer at
+    // produced % ring.size() while read() drains the one at consumed %
+    // ring.size(), so neither buffer needs the lock while in use.
+    std::vector<std::vector<char>> ring;
+    std::vector<size_t> lens;
+    size_t produced;
+    size_t consumed;
+    // How much of the buffer being drained has been read
+    size_t pos;
+    bool done;
+    bool failed;
+    bool stopped;
+    std::mutex mtx;
+    std::condition_variable cv_full;
+    std::condition_variable cv_free;
+    std::thread thread;
+    decompressor(int fd, size_t buffer_size, size_t ring_size);
+    decompressor(const decompressor&) = delete;
+    decompressor& operator=(const decompressor&) = delete;
+    ~decompressor();
+    // Copies up to len bytes of decompressed input into buf, setting *nread
+    // to the number of bytes copied, which is 0 at the end of the input.
+    // Returns false and sets error if the input could not be read or
+    // decompressed. Suitable for use as a sqltoast::stream_reader_t.
+    bool read(char* buf, size_t len, size_t* nread);
+
+    // The rest is used by the decompressing thread
+    void run();
+    // Returns the buffer to fill next, waiting for read() to drain one if the
+    // ring is full, or nullptr if the decompressor is being destroyed
+    char* acquire();
+    // Hands the len bytes in the buffer returned by acquire() to read()
+    void publish(size_t len);
+    // Ends the input, with the supplied error if it isn't empty
+    void finish(const std::string& err);
+    bool copy_plain(const char* first, size_t first_len, std::string& err);
+    bool inflate_gzip(const char* first, size_t first_len, std::string& err);
+    bool decompress_zstd(const char* first, size_t first_len, std::string& err);
+} decompressor_t;
+
+} // namespace sqltoaster
+
+#endif /* SQLTOASTER_DECOMPRESS_H */
@@ -4,31 +4,220 @@
  * See the COPYING file in the root project directory for full text.
  */
 
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 
+#include <sqltoast/print.h>
 #include <sqltoast/sqltoast.h>
 
+#include "decompress.h"
+#include "mapped_file.h"
 #include "measure.h"
 #include "printer.h"
 
 struct parser {
     sqltoast::parse_options_t opts;
-    sqltoast::parse_input_t subject;
+    const char* subject;
+    size_t subject_len;
+    // When not NULL, the same input copied into a padded buffer, which is
+    // parsed instead
+    sqltoast::padded_input_t* padded;
     sqltoast::parse_result_t res;
-    parser(sqltoast::parse_options_t& opts, const std::string &input) :
+    parser(
+            sqltoast::parse_options_t& opts,
+            const char* input,
+            size_t len,
+            sqltoast::padded_input_t* padded) :
         opts(opts),
-        subject(input.cbegin(), input.cend())
+        subject(input),
+        subject_len(len),
+        padded(padded)
     {}
     void operator()() {
-        res = sqltoast::parse(subject, opts);
+        if (padded != nullptr)
+            res = sqltoast::parse(*padded, opts);
+        else
+            res = sqltoast::parse(subject, subject_len, opts);
     }
 };
 
+// Parses a file in windows of a fixed size instead of all at once, counting
+// but otherwise ignoring the statements found. The file is read, and
+// decompressed if need be, on another thread while the statements already
+// read are parsed.
+struct stream_parser {
+    sqltoast::parse_options_t opts;
+    int fd;
+    size_t window_size;
+    sqltoast::stream_result_t res;
+    std::string read_error;
+    stream_parser(sqltoast::parse_options_t& opts, int fd, size_t window_size) :
+        opts(opts),
+        fd(fd),
+        window_size(window_size)
+    {}
+    void operator()() {
+        sqltoaster::decompressor_t dc(fd, window_size,
+                sqltoaster::DECOMPRESS_RING_SIZE);
+        res = sqltoast::parse_stream(
+                [&dc](char* buf, size_t len, size_t* nread) {
+                    return dc.read(buf, len, nread);
+                },
+                [](const sqltoast::statement_t&) { return true; },
+                opts, window_size);
+        // The decompressing thread only sets the error before ending the
+        // input, which read() must have seen for there to be an input error
+        if (res.code == sqltoast::PARSE_INPUT_ERROR)
+            read_error = dc.error;
+    }
+};
+
+// Parses SQL given on the command line as if it arrived chunk_size bytes at a
+// time, either reading it with parse_stream() or feeding it to a
+// push_parser_t, and prints each statement as it is handed to the handler
+struct chunk_parser {
+    sqltoast::parse_options_t opts;
+    const char* subject;
+    size_t subject_len;
+    size_t chunk_size;
+    bool push;
+    sqltoast::stream_result_t res;
+    chunk_parser(
+            sqltoast::parse_options_t& opts,
+            const char* input,
+            size_t len,
+            size_t chunk_size,
+            bool push) :
+        opts(opts),
+        subject(input),
+        subject_len(len),
+        chunk_size(chunk_size),
+        push(push)
+    {}
+    void operator()() {
+        size_t count = 0;
+        sqltoast::stream_handler_t handler =
+            [&count](const sqltoast::statement_t& stmt) {
+                std::cout << "statements[" << count++ << "]:" << std::endl;
+                std::cout << "  " << stmt << std::endl;
+                return true;
+            };
+        if (push) {
+            sqltoast::push_parser_t pp(opts, handler);
+            for (size_t x = 0; x < subject_len; x += chunk_size)
+                pp.feed(subject + x, std::min(chunk_size, subject_len - x));
+            pp.finish();
+            res = pp.result;
+            return;
+        }
+        size_t pos = 0;
+        res = sqltoast::parse_stream(
+                [this, &pos](char* buf, size_t len, size_t* nread) {
+                    size_t n = std::min(std::min(len, chunk_size),
+                            subject_len - pos);
+                    memcpy(buf, subject + pos, n);
+                    pos += n;
+                    *nread = n;
+                    return true;
+                },
+                handler, opts, chunk_size);
+    }
+};
+
+void print_stream_result(
+        const sqltoast::stream_result_t& res,
+        const std::string& read_error) {
+    if (res.code == sqltoast::PARSE_OK) {
+        std::cout << "Parsed " << res.statement_count << " statements." <<
+            std::endl;
+    } else if (res.code == sqltoast::PARSE_INPUT_ERROR) {
+        std::cout << "Input error at offset " << res.error_offset << ": " <<
+            res.error;
+        if (! read_error.empty())
+            std::cout << " " << read_error;
+        std::cout << std::endl;
+    } else {
+        std::cout << "Syntax error in statement at offset " <<
+            res.error_offset << "." << std::endl;
+        std::cout << res.error << std::endl;
+    }
+}
+
+// Prints the tokens in the input one per line, along with the decoded value
+// of any numeric literal
+void print_tokens(const char* subject, size_t subject_len) {
+    for (const sqltoast::token_t& tok :
+            sqltoast::tokenize(subject, subject_len)) {
+        // An error token spans the bytes the lexer could not tokenize, which
+        // operator<< does not show
+        if (tok.symbol == sqltoast::SYMBOL_ERROR) {
+            std::cout << "error[length: " <<
+                (tok.lexeme.end - tok.lexeme.start) << "]" << std::endl;
+            continue;
+        }
+        std::cout << tok;
+        switch (tok.value.type) {
+            case sqltoast::LITERAL_VALUE_UNSIGNED_INTEGER:
+                std::cout << " = " << tok.value.uint_value;
+                break;
+            case sqltoast::LITERAL_VALUE_SIGNED_INTEGER:
+                std::cout << " = " << tok.value.int_value;
+                break;
+            case sqltoast::LITERAL_VALUE_DOUBLE:
+                std::cout << " = " << std::setprecision(17) <<
+                    tok.value.double_value;
+                break;
+            case sqltoast::LITERAL_VALUE_OVERFLOW:
+                std::cout << " = overflow";
+                break;
+            default:
+                break;
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Prints the offset and length of each statement split_statements() finds in
+// the input, one per line, followed by the statement's bytes with any
+// newlines written as \n
+void print_split(const char* subject, size_t subject_len) {
+    for (const sqltoast::statement_range_t& r :
+            sqltoast::split_statements(subject, subject_len)) {
+        std::cout << "statement[" << r.offset << ":" << r.len << "]: ";
+        for (size_t x = r.offset; x < r.offset + r.len; x++) {
+            if (subject[x] == '\n')
+                std::cout << "\\n";
+            else
+                std::cout << subject[x];
+        }
+        std::cout << std::endl;
+    }
+}
+
 void usage(const char* prg_name) {
     std::cout << "Usage: " << prg_name <<
-        " [--disable-timer] [--yaml] <SQL>" << std::endl;
+        " [--disable-timer] [--yaml] [--tokenize-once] [--structural-index]"
+        " [--threads <N>] [--padded] <SQL>" << std::endl;
+    std::cout << "       " << prg_name <<
+        " [--disable-timer] [--yaml] [--tokenize-once] [--structural-index]"
+        " [--threads <N>] [--padded] [--populate] [--sequential]"
+        " --file <PATH>" << std::endl;
+    std::cout << "       " << prg_name <<
+        " [--disable-timer] [--tokenize-once] [--structural-index] --stream"
+        " [--chunk-size <N>] --file <PATH|->" << std::endl;
+    std::cout << "       " << prg_name <<
+        " [--disable-timer] [--tokenize-once] [--structural-index]"
+        " --stream|--push [--chunk-size <N>] <SQL>" << std::endl;
+    std::cout << "       " << prg_name << " --tokens <SQL>" << std::endl;
+    std::cout << "       " << prg_name << " --split <SQL>" << std::endl;
     std::cout << " using libsqltoast version " <<
         SQLTOAST_VERSION_MAJOR << '.' <<
         SQLTOAST_VERSION_MINOR << std::endl;
@@ -37,8 +226,21 @@ void usage(const char* prg_name) {
 int main (int argc, char *argv[])
 {
     std::string input;
+    bool have_input = false;
     bool disable_timer = false;
     bool use_yaml = false;
+    bool tokenize_once = false;
+    bool structural_index = false;
+    size_t num_threads = 0;
+    const char* file_path = nullptr;
+    bool populate = false;
+    bool sequential = false;
+    bool stream = false;
+    bool tokens = false;
+    bool split = false;
+    bool push = false;
+    bool padded = false;
+    size_t chunk_size = sqltoast::STREAM_WINDOW_SIZE;
 
     for (int x = 1; x < argc; x++) {
         if (strcmp(argv[x], "--disable-timer") == 0) {
@@ -49,16 +251,141 @@ int main (int argc, char *argv[])
             use_yaml = true;
             continue;
         }
+        if (strcmp(argv[x], "--tokenize-once") == 0) {
+            tokenize_once = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--structural-index") == 0) {
+            structural_index = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--threads") == 0) {
+            if (++x < argc)
+                num_threads = strtoul(argv[x], nullptr, 10);
+            continue;
+        }
+        if (strcmp(argv[x], "--populate") == 0) {
+            populate = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--sequential") == 0) {
+            sequential = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--stream") == 0) {
+            stream = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--padded") == 0) {
+            padded = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--push") == 0) {
+            push = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--chunk-size") == 0) {
+            if (++x < argc)
+                chunk_size = strtoul(argv[x], nullptr, 10);
+            continue;
+        }
+        if (strcmp(argv[x], "--tokens") == 0) {
+            tokens = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--split") == 0) {
+            split = true;
+            continue;
+        }
+        if (strcmp(argv[x], "--file") == 0) {
+            if (++x < argc)
+                file_path = argv[x];
+            break;
+        }
         input.assign(argv[x]);
+        have_input = true;
         break;
     }
-    if (input.empty()) {
+    if (! have_input && file_path == nullptr) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (chunk_size == 0) {
         usage(argv[0]);
         return 1;
     }
 
-    sqltoast::parse_options_t opts = {sqltoast::SQL_DIALECT_ANSI_1992, false};
-    parser p(opts, input);
+    if (tokens && ! input.empty()) {
+        print_tokens(input.data(), input.size());
+        return 0;
+    }
+    if (split && ! input.empty()) {
+        print_split(input.data(), input.size());
+        return 0;
+    }
+
+    sqltoast::parse_options_t opts = {
+        sqltoast::SQL_DIALECT_ANSI_1992,
+        false,
+        tokenize_once,
+        structural_index,
+        num_threads
+    };
+
+    // When streaming, the file is read a window at a time, so it may be of
+    // any size. A path of - streams standard input. gzip- and
+    // zstd-compressed input is decompressed as it is read.
+    if (stream && file_path != nullptr) {
+        int fd = STDIN_FILENO;
+        if (strcmp(file_path, "-") != 0) {
+            fd = open(file_path, O_RDONLY);
+            if (fd == -1) {
+                std::cerr << "Failed to open file " << file_path << ": " <<
+                    strerror(errno) << std::endl;
+                return 1;
+            }
+        }
+        stream_parser sp(opts, fd, chunk_size);
+        auto dur = measure<std::chrono::nanoseconds>::execution(sp);
+        if (fd != STDIN_FILENO)
+            close(fd);
+        print_stream_result(sp.res, sp.read_error);
+        if (! disable_timer)
+            std::cout << "(took " << dur << " nanoseconds)" << std::endl;
+        return 0;
+    }
+
+    // SQL given on the command line can be streamed or pushed too, a chunk at
+    // a time, to show how statements cut into pieces are parsed
+    if ((stream || push) && file_path == nullptr) {
+        chunk_parser cp(opts, input.data(), input.size(), chunk_size, push);
+        auto dur = measure<std::chrono::nanoseconds>::execution(cp);
+        print_stream_result(cp.res, std::string());
+        if (! disable_timer)
+            std::cout << "(took " << dur << " nanoseconds)" << std::endl;
+        return 0;
+    }
+
+    // When parsing a file, the file is mapped into memory and parsed in place
+    sqltoaster::mapped_file_t file;
+    const char* subject = input.data();
+    size_t subject_len = input.size();
+    if (file_path != nullptr) {
+        if (! file.open(file_path, populate, sequential)) {
+            std::cerr << "Failed to map file " << file.error << std::endl;
+            return 1;
+        }
+        subject = file.data;
+        subject_len = file.size;
+    }
+
+    // With --padded, the input is copied into a padded_input_t first, so that
+    // the lexer uses its padded scanners
+    std::unique_ptr<sqltoast::padded_input_t> padded_input;
+    if (padded)
+        padded_input = std::make_unique<sqltoast::padded_input_t>(subject,
+                subject_len);
+    parser p(opts, subject, subject_len, padded_input.get());
 
     auto dur = measure<std::chrono::nanoseconds>::execution(p);
     sqltoaster::printer ptr(p.res, std::cout);
@@ -0,0 +1,61 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.h"
+
+namespace sqltoaster {
+
+mapped_file::~mapped_file() {
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+}
+
+bool mapped_file::open(const char* path, bool populate, bool sequential) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd == -1) {
+        error.assign(path).append(": ").append(strerror(errno));
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        error.assign(path).append(": ").append(strerror(errno));
+        close(fd);
+        return false;
+    }
+    // An empty file cannot be mapped. We leave data NULL and let the parser
+    // report that there is nothing to parse.
+    if (st.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+    if (populate)
+        flags |= MAP_POPULATE;
+#endif
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, flags, fd, 0);
+    // The mapping holds its own reference to the file
+    close(fd);
+    if (addr == MAP_FAILED) {
+        error.assign(path).append(": ").append(strerror(errno));
+        return false;
+    }
+    if (sequential)
+        madvise(addr, st.st_size, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(addr);
+    size = st.st_size;
+    return true;
+}
+
+} // namespace sqltoaster
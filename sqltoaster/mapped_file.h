@@ -0,0 +1,41 @@
+/*
+ * Use and distribution licensed under the Apache license version 2.
+ *
+ * See the COPYING file in the root project directory for full text.
+ */
+
+#ifndef SQLTOASTER_MAPPED_FILE_H
+#define SQLTOASTER_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace sqltoaster {
+
+// A read-only memory mapping of an entire file. The mapped bytes are parsed
+// in place, so a file of any size is read into memory only by the kernel
+// paging it in, with no read() copies and no limit from the size of argv.
+typedef struct mapped_file {
+    const char* data;
+    size_t size;
+    // Set when open() fails
+    std::string error;
+    mapped_file() :
+        data(nullptr),
+        size(0)
+    {}
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    ~mapped_file();
+    // Maps the file at the supplied path. If populate is true, the whole file
+    // is faulted in up front (MAP_POPULATE) instead of a page at a time as
+    // the parser reaches it. If sequential is true, the kernel is advised
+    // that the mapping will be read from start to end (MADV_SEQUENTIAL), so
+    // it can read ahead aggressively and drop pages behind the parser.
+    // Returns false and sets error if the file could not be mapped.
+    bool open(const char* path, bool populate, bool sequential);
+} mapped_file_t;
+
+} // namespace sqltoaster
+
+#endif /* SQLTOASTER_MAPPED_FILE_H */
@@ -13,6 +13,50 @@ RESULT_TEST_ERROR = 1
 RESULT_TEST_FAILURE = 1
 SQLTOASTER_BINARY = os.path.join(TEST_DIR, '..', '..', '_build', 'sqltoaster',
                                  'sqltoaster')
+# A comment line starting with this gives extra arguments to pass to
+# sqltoaster for the tests that follow it in the file
+ARGS_DIRECTIVE = "# sqltoaster-args:"
+# The number of rows of a VALUES list that sqltoaster parses in one chunk
+# when parsing on several threads. A list needs at least two chunks of rows
+# before any are parsed on another thread.
+TVC_ROWS_PER_CHUNK = 1024
+# The number of threads generated tests parse on when --threads is not given
+GENERATED_TEST_THREADS = 4
+
+
+def gen_insert_values_rows():
+    """Returns an INSERT with enough rows in its VALUES list to be parsed on
+    several threads, one row per line."""
+    rows = ["(%d, 'row %d')" % (x, x)
+            for x in range(3 * TVC_ROWS_PER_CHUNK)]
+    return "INSERT INTO t1 VALUES\n" + ",\n".join(rows)
+
+
+def gen_insert_values_bad_row():
+    """Returns an INSERT like gen_insert_values_rows() with a row past the
+    first chunk that fails to parse."""
+    rows = ["(%d, 'row %d')" % (x, x)
+            for x in range(3 * TVC_ROWS_PER_CHUNK)]
+    rows[TVC_ROWS_PER_CHUNK + 100] = "(%d, )" % (TVC_ROWS_PER_CHUNK + 100)
+    return "INSERT INTO t1 VALUES\n" + ",\n".join(rows)
+
+
+# Tests whose SQL is generated rather than read from a test file, because it
+# is too long to keep in one. Each checks that sqltoaster prints the same
+# output parsing on several threads as it does parsing on one, and that the
+# output begins with the lines given.
+GENERATED_TESTS = {
+    'ansi-92/generated-insert-values-rows': (
+        gen_insert_values_rows,
+        ["statements:", "  - type: INSERT"],
+    ),
+    'ansi-92/generated-insert-values-bad-row': (
+        gen_insert_values_bad_row,
+        ["Syntax error.",
+         "Expected a value item but found symbol[')']",
+         "Line %d, column 8:" % (TVC_ROWS_PER_CHUNK + 102)],
+    ),
+}
 
 
 def parse_options():
@@ -28,6 +72,17 @@ def parse_options():
                    help="(optional) Only run SQL grammar tests for the "
                         "dialect specified. By default, all dialect tests "
                         "are run")
+    p.add_argument("--threads", type=int, default=None,
+                   help="(optional) Have sqltoaster parse on this many "
+                        "threads. The expected output is the same, so this "
+                        "checks that splitting the input into statements "
+                        "and parsing them in parallel does not change what "
+                        "parses")
+    p.add_argument("--padded", action="store_true",
+                   help="(optional) Have sqltoaster parse each test's SQL "
+                        "from a padded_input_t. The expected output is the "
+                        "same, so this checks that the lexer's padded "
+                        "scanners agree with the unpadded ones")
 
     return p.parse_args()
 
@@ -64,21 +119,73 @@ def get_test_names(args):
                     if not name_regex.search(fname):
                         continue
                 test_names.append("%s/%s" % (dialect, fname[:-5]))
+    for tname in GENERATED_TESTS:
+        if tname.split("/")[0] not in dialects:
+            continue
+        if name_regex and not name_regex.search(tname.split("/")[1]):
+            continue
+        test_names.append(tname)
     return sorted(test_names)
 
 
-def run_test(test_name):
+def run_generated_test(test_name, args):
+    generator, expected_head = GENERATED_TESTS[test_name]
+    input_sql = generator()
+    cmd_args = [SQLTOASTER_BINARY, '--disable-timer', '--yaml']
+    if args.padded:
+        cmd_args.append('--padded')
+    threads = args.threads
+    if threads is None or threads < 2:
+        threads = GENERATED_TEST_THREADS
+    try:
+        expected = subprocess.check_output(cmd_args + [input_sql])
+        actual = subprocess.check_output(
+            cmd_args + ['--threads', str(threads), input_sql])
+    except subprocess.CalledProcessError as err:
+        msg = ("Failed to execute generated test %s. Got: %s")
+        msg = msg % (test_name, err)
+        return RESULT_TEST_ERROR, msg
+
+    expected = expected.splitlines()
+    actual = actual.splitlines()
+    if expected[:len(expected_head)] != expected_head:
+        msg = "Generated test %s\n" % test_name
+        msg += "---------------------------------------------\n"
+        msg += "output on one thread does not begin with:\n"
+        msg += "\n".join(expected_head)
+        msg += "\n---------------------------------------------\n"
+        msg += "Got:\n"
+        msg += "\n".join(expected[:len(expected_head)])
+        return RESULT_TEST_FAILURE, msg
+    if actual != expected:
+        msg = "Generated test %s\n" % test_name
+        msg += "---------------------------------------------\n"
+        msg += "output on one thread != output on %d threads\n" % threads
+        diffs = difflib.unified_diff(expected, actual, lineterm="")
+        msg += "\n".join(diffs)
+        return RESULT_TEST_FAILURE, msg
+
+    return RESULT_OK, None
+
+
+def run_test(test_name, args):
+    if test_name in GENERATED_TESTS:
+        return run_generated_test(test_name, args)
     test_path = os.path.join(TEST_DIR, test_name + ".test")
     input_blocks = []
     output_blocks = []
     input_block = []
     output_block = []
+    extra_args = []
+    block_args = []
     with open(test_path, 'rb') as tfile:
         line = tfile.readline().rstrip("\n")
         while True:
             if not line:
                 break;
             if line.startswith("#"):
+                if line.startswith(ARGS_DIRECTIVE):
+                    extra_args = line[len(ARGS_DIRECTIVE):].split()
                 line = tfile.readline().rstrip("\n")
                 continue
             if line.startswith('>'):
@@ -86,6 +193,8 @@ def run_test(test_name):
                 if output_block:
                     output_blocks.append(output_block)
                     output_block = []
+                if not input_block:
+                    block_args.append(extra_args)
                 input_block.append(line[1:])
             else:
                 # Clear out previous input block...
@@ -105,7 +214,13 @@ def run_test(test_name):
     for testno, iblock in enumerate(input_blocks):
         expected = output_blocks[testno]
         input_sql = "\n".join(iblock)
-        cmd_args = [SQLTOASTER_BINARY, '--disable-timer', '--yaml', input_sql]
+        cmd_args = [SQLTOASTER_BINARY, '--disable-timer', '--yaml']
+        if args.threads is not None:
+            cmd_args += ['--threads', str(args.threads)]
+        if args.padded:
+            cmd_args.append('--padded')
+        cmd_args += block_args[testno]
+        cmd_args.append(input_sql)
         try:
             actual = subprocess.check_output(cmd_args)
         except subprocess.CalledProcessError as err:
@@ -142,7 +257,7 @@ def command_run(args):
     test_names = get_test_names(args)
     for tname in test_names:
         sys.stdout.write("Running %s ... " % tname)
-        res, err = run_test(tname)
+        res, err = run_test(tname, args)
         if res == RESULT_OK:
             sys.stdout.write("OK\n")
         elif res == RESULT_TEST_ERROR: